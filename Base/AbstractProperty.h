@@ -11,6 +11,7 @@
 #ifndef GUI_ABSTRACT_PROPERTY_H
 #define GUI_ABSTRACT_PROPERTY_H
 
+#include "ComponentAllocator.h"
 #include <Util/ReferenceCounter.h>
 #include <Util/TypeNameMacro.h>
 
@@ -25,7 +26,9 @@ class StyleManager;
 //! DisplayProperty
 class DisplayProperty : public Util::ReferenceCounter<DisplayProperty> {
 		PROVIDES_TYPE_NAME(DisplayProperty)
+		PROVIDES_POOLED_ALLOCATION()
 
+	private:
 		propertyId_t propertyId;
 	public:
 		DisplayProperty(propertyId_t _propertyId) : propertyId(_propertyId) {}
@@ -0,0 +1,112 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "ComponentAllocator.h"
+#include <array>
+#include <mutex>
+#include <new>
+
+namespace GUI {
+
+static const size_t NUM_SIZE_CLASSES = ComponentAllocator::MAX_BLOCK_SIZE/ComponentAllocator::GRANULARITY;
+
+struct FreeBlock{
+	FreeBlock * next;
+};
+
+struct Pool{
+	std::mutex mutex;
+	std::array<FreeBlock *,NUM_SIZE_CLASSES> freeLists;
+	char * chunkCursor;		//!< unused part of the current chunk
+	size_t chunkRemaining;
+	size_t numChunks;
+	size_t numUsedBlocks;
+
+	Pool() : chunkCursor(nullptr), chunkRemaining(0), numChunks(0), numUsedBlocks(0) {
+		freeLists.fill(nullptr);
+	}
+};
+
+/*! (internal) The pool is never destroyed, as components may still be released
+	by other static objects after the end of main().	*/
+static Pool & getPool(){
+	static Pool * pool = new Pool;
+	return *pool;
+}
+
+//! (internal)
+static size_t getSizeClass(size_t size){
+	return size==0 ? 0 : (size-1)/ComponentAllocator::GRANULARITY;
+}
+
+//! (static)
+void * ComponentAllocator::allocate(size_t size){
+	if(size>MAX_BLOCK_SIZE)
+		return ::operator new(size);
+	const size_t sizeClass = getSizeClass(size);
+	const size_t blockSize = (sizeClass+1)*GRANULARITY;
+	Pool & pool = getPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	++pool.numUsedBlocks;
+	FreeBlock * block = pool.freeLists[sizeClass];
+	if(block!=nullptr){
+		pool.freeLists[sizeClass] = block->next;
+		return block;
+	}
+	if(pool.chunkRemaining<blockSize){
+		// the rest of the current chunk is handed to the free list of the fitting size class
+		if(pool.chunkRemaining>=GRANULARITY){
+			FreeBlock * rest = reinterpret_cast<FreeBlock*>(pool.chunkCursor);
+			const size_t restClass = pool.chunkRemaining/GRANULARITY-1;
+			rest->next = pool.freeLists[restClass];
+			pool.freeLists[restClass] = rest;
+		}
+		pool.chunkCursor = static_cast<char*>(::operator new(CHUNK_SIZE));
+		pool.chunkRemaining = CHUNK_SIZE;
+		++pool.numChunks;
+	}
+	void * p = pool.chunkCursor;
+	pool.chunkCursor += blockSize;
+	pool.chunkRemaining -= blockSize;
+	return p;
+}
+
+//! (static)
+void ComponentAllocator::deallocate(void * p, size_t size){
+	if(p==nullptr)
+		return;
+	if(size>MAX_BLOCK_SIZE){
+		::operator delete(p);
+		return;
+	}
+	const size_t sizeClass = getSizeClass(size);
+	Pool & pool = getPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	--pool.numUsedBlocks;
+	FreeBlock * block = static_cast<FreeBlock*>(p);
+	block->next = pool.freeLists[sizeClass];
+	pool.freeLists[sizeClass] = block;
+}
+
+//! (static)
+size_t ComponentAllocator::getNumberOfChunks(){
+	Pool & pool = getPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	return pool.numChunks;
+}
+
+//! (static)
+size_t ComponentAllocator::getNumberOfUsedBlocks(){
+	Pool & pool = getPool();
+	std::lock_guard<std::mutex> lock(pool.mutex);
+	return pool.numUsedBlocks;
+}
+
+}
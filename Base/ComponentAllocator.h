@@ -0,0 +1,53 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_COMPONENT_ALLOCATOR_H
+#define GUI_COMPONENT_ALLOCATOR_H
+
+#include <cstddef>
+
+namespace GUI {
+
+/***
+ **	ComponentAllocator
+ **	Pool for the many small, individually reference counted objects of the gui
+ **	(components, layouters and display properties).
+ **	Objects are grouped into size classes (multiples of GRANULARITY bytes); the blocks of a size class
+ **	are cut from large chunks and released blocks are kept in a free list of their size class.
+ **	Allocating or releasing a block is therefore a pointer swap instead of a call to the system allocator;
+ **	chunks are never returned, so the memory of destroyed components is reused by the next ones.
+ **	Objects larger than MAX_BLOCK_SIZE are allocated directly.
+ **	\note Use the PROVIDES_POOLED_ALLOCATION() macro in the (base) class to use the pool.
+ **/
+class ComponentAllocator{
+	public:
+		static const size_t GRANULARITY = 16;
+		static const size_t MAX_BLOCK_SIZE = 1024;
+		static const size_t CHUNK_SIZE = 64*1024;
+
+		static void * allocate(size_t size);
+		static void deallocate(void * p, size_t size);
+
+		//! Number of chunks allocated by the pool.
+		static size_t getNumberOfChunks();
+		//! Number of pooled blocks currently in use.
+		static size_t getNumberOfUsedBlocks();
+};
+
+}
+
+/*! Class specific allocation functions using the ComponentAllocator.
+	The sized delete receives the size of the dynamic type, as the classes using it have a virtual destructor.	*/
+#define PROVIDES_POOLED_ALLOCATION() \
+	public: \
+		static void * operator new(std::size_t size)			{	return GUI::ComponentAllocator::allocate(size);	} \
+		static void operator delete(void * p, std::size_t size)	{	GUI::ComponentAllocator::deallocate(p,size);	}
+
+#endif // GUI_COMPONENT_ALLOCATOR_H
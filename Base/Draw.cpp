@@ -19,6 +19,12 @@
 #include <Util/Graphics/PixelFormat.h>
 #include <iostream>
 #include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GUI_DRAW_USE_SSE2
+#endif
 
 namespace GUI{
 
@@ -34,12 +40,28 @@ struct DrawContext{
 	GLint u_color,	u_colorAttrEnabled, u_posOffset, u_screenScale, u_textureEnabled, u_useVertexColor;
 	Geometry::Vec2i position,screenSize;
 	uint8_t* vboPtr = nullptr;
+	bool drawing;			//!< true between beginDrawing() and endDrawing()
+	bool textureEnabled;
+	GLint scissor[4];		//!< current scissor box (in gl coordinates)
 	DrawContext() : useShader(true),shaderProg(0),activeTextureId(0),nullTexture(0),
-	vertexBuffer(0),vertexBufferOffset(1048576),vertexBufferSize(1048576) {} // allocate 1MB vertex buffer
+	vertexBuffer(0),vertexBufferOffset(1048576),vertexBufferSize(1048576), // allocate 1MB vertex buffer
+	drawing(false),textureEnabled(false),scissor{0,0,0,0} {}
 };
 
 static DrawContext ctxt;
 
+/*! (internal) Glyph quads of all texts using the same font texture since the last flush.
+	The positions include the cursor position at the time the text was added and the color is stored per vertex,
+	so the texts of different components are drawn by a single draw call.	*/
+struct TextBatch{
+	GLuint textureId;
+	std::vector<GLfloat> posAndUV;
+	std::vector<uint32_t> colors;
+	TextBatch() : textureId(0) {}
+};
+
+static TextBatch textBatch;
+
 static const char * const vs = 
 R"***(#version 130
 in vec4 attr_color;
@@ -138,8 +160,53 @@ static const uint8_t* updateBuffer(size_t size, const uint8_t * data) {
 	return offset;
 }
 
+//! (internal) Draw and clear the collected text.
+static void flushTextBatch(){
+	if(textBatch.colors.empty())
+		return;
+	const size_t numVertices = textBatch.colors.size();
+
+	// the batch may be flushed by a function that has already set up its own blending (e.g. dropShadow)
+	const GLboolean blendEnabled = glIsEnabled(GL_BLEND);
+	GLint blendFunc[4]; // src rgb, dst rgb, src alpha, dst alpha
+	glGetIntegerv(GL_BLEND_SRC_RGB,&blendFunc[0]);
+	glGetIntegerv(GL_BLEND_DST_RGB,&blendFunc[1]);
+	glGetIntegerv(GL_BLEND_SRC_ALPHA,&blendFunc[2]);
+	glGetIntegerv(GL_BLEND_DST_ALPHA,&blendFunc[3]);
+	if(!blendEnabled)
+		glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
+	if(ctxt.activeTextureId != textBatch.textureId)
+		glBindTexture(GL_TEXTURE_2D,textBatch.textureId);
+	glUniform1i(ctxt.u_textureEnabled,1);
+	glUniform1i(ctxt.u_colorAttrEnabled,1);
+	glUniform2f(ctxt.u_posOffset,0,0);
+
+	ensureBufferSize(numVertices * (4*sizeof(GLfloat) + sizeof(uint32_t)) + 64);
+	auto vPtr = updateBuffer(numVertices * 4 * sizeof(GLfloat), reinterpret_cast<const uint8_t*>(textBatch.posAndUV.data()));
+	auto cPtr = updateBuffer(numVertices * sizeof(uint32_t), reinterpret_cast<const uint8_t*>(textBatch.colors.data()));
+	glVertexAttribPointer(ctxt.attr_vertex,2,GL_FLOAT,GL_FALSE,sizeof(GLfloat)*4,vPtr);
+	glVertexAttribPointer(ctxt.attr_uv,2,GL_FLOAT,GL_FALSE,sizeof(GLfloat)*4,vPtr + 2*sizeof(GLfloat));
+	glVertexAttribPointer(ctxt.attr_color,4,GL_UNSIGNED_BYTE,GL_TRUE,0,cPtr);
+	glDrawArrays(GL_TRIANGLES, 0, numVertices);
+
+	// restore the state expected by the other drawing functions
+	glUniform2f(ctxt.u_posOffset,ctxt.position.x(),ctxt.position.y());
+	glUniform1i(ctxt.u_colorAttrEnabled,0);
+	glUniform1i(ctxt.u_textureEnabled,ctxt.textureEnabled ? 1 : 0);
+	if(ctxt.activeTextureId != textBatch.textureId)
+		glBindTexture(GL_TEXTURE_2D,ctxt.activeTextureId);
+	glBlendFuncSeparate(blendFunc[0],blendFunc[1],blendFunc[2],blendFunc[3]);
+	if(!blendEnabled)
+		glDisable(GL_BLEND);
+
+	textBatch.posAndUV.clear();
+	textBatch.colors.clear();
+}
+
 static void drawVertices(const GLenum mode,size_t numVertices,const GLfloat * vertices, const Util::Color4ub & color){
 	//checkGLError(__LINE__);
+	flushTextBatch();
 	if(ctxt.useShader){
 		const Util::Color4f c2(color);
 		glUniform4fv(ctxt.u_color,1,c2.data());
@@ -164,6 +231,7 @@ static void drawVertices(const GLenum mode,size_t numVertices,const GLfloat * ve
 
 static void drawVertices(const GLenum mode,size_t numVertices,const GLfloat * vertices, const uint32_t * colors){
 	//checkGLError(__LINE__);
+	flushTextBatch();
 	if(ctxt.useShader){	
 		glUniform1i(ctxt.u_colorAttrEnabled,1);
 				
@@ -192,6 +260,7 @@ static void drawVertices(const GLenum mode,size_t numVertices,const GLfloat * ve
 
 static void drawTexturedVertices(const GLenum mode,size_t numVertices,const GLfloat * verticesAndUVs, const Util::Color4ub & color){
 	//checkGLError(__LINE__);
+	flushTextBatch();
 	if(ctxt.useShader){		
 		auto ptr = updateBuffer(numVertices * 4 * sizeof(GLfloat), reinterpret_cast<const uint8_t*>(verticesAndUVs));
 		
@@ -216,7 +285,6 @@ static void drawTexturedVertices(const GLenum mode,size_t numVertices,const GLfl
 	//checkGLError(__LINE__);
 }
 
-
 //! (internal)
 static GLuint createShaderObject(const GLuint type,const char * code){
 	//checkGLError(__LINE__);
@@ -344,7 +412,10 @@ void Draw::beginDrawing(const Geometry::Vec2i & screenSize){
 	glEnable(GL_SCISSOR_TEST);
 	
 	ctxt.screenSize = screenSize;
+	ctxt.scissor[2] = -1; // the scissor box may have been changed outside of the gui
 	resetScissor();
+	ctxt.drawing = true;
+	ctxt.textureEnabled = false;
 	
 	if(ctxt.useShader){
 	
@@ -385,6 +456,8 @@ void Draw::beginDrawing(const Geometry::Vec2i & screenSize){
 
 //! (static)
 void Draw::endDrawing(){
+	flushTextBatch();
+	ctxt.drawing = false;
 	checkGLError(__LINE__);
 	if(ctxt.useShader){	
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -423,18 +496,31 @@ Geometry::Rect_i Draw::queryViewport(){
 	return Geometry::Rect_i(viewport[0],viewport[1],viewport[2],viewport[3]);
 }
 
+//! (internal) Changing the scissor box ends the current text batch; setting the same box again is ignored.
+static void updateScissor(GLint x, GLint y, GLint width, GLint height){
+	if(ctxt.scissor[0]==x && ctxt.scissor[1]==y && ctxt.scissor[2]==width && ctxt.scissor[3]==height)
+		return;
+	flushTextBatch();
+	ctxt.scissor[0] = x;
+	ctxt.scissor[1] = y;
+	ctxt.scissor[2] = width;
+	ctxt.scissor[3] = height;
+	glScissor(x, y, width, height);
+}
+
 //! (static)
 void Draw::setScissor(const Geometry::Rect_i & rect){
-	glScissor(rect.getX(), ctxt.screenSize.getHeight()-rect.getY()-rect.getHeight(), rect.getWidth(), rect.getHeight());
+	updateScissor(rect.getX(), ctxt.screenSize.getHeight()-rect.getY()-rect.getHeight(), rect.getWidth(), rect.getHeight());
 }
 
 //! (static)
 void Draw::resetScissor(){
-	glScissor(0,0,ctxt.screenSize.getWidth(),ctxt.screenSize.getHeight());
+	updateScissor(0,0,ctxt.screenSize.getWidth(),ctxt.screenSize.getHeight());
 }
 
 //! (static)
 void Draw::clearScreen(const Util::Color4ub & color){
+	flushTextBatch();
 	glClearColor(color.getR(), color.getG(), color.getB(), color.getA());
 	glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -470,6 +556,45 @@ void Draw::drawText(const std::string & text,const Geometry::Rect & rect,Abstrac
 	font->disable();
 }
 
+//! (static)
+void Draw::drawTextGlyphs(uint32_t textureId, const float * posAndUV, size_t numValues, const Util::Color4ub & c){
+	if(numValues==0)
+		return;
+	const size_t numVertices = numValues / 4;
+	const size_t maxBatchSize = static_cast<size_t>(ctxt.vertexBufferSize) / 2;
+	const size_t vertexSize = 4*sizeof(GLfloat) + sizeof(uint32_t);
+	if(!ctxt.useShader || !ctxt.drawing || numVertices*vertexSize>maxBatchSize){ // draw directly
+		flushTextBatch();
+		const bool textureEnabled = ctxt.textureEnabled;
+		const uint32_t prevTextureId = ctxt.activeTextureId;
+		enableTexture(textureId);
+		drawTexturedTriangles(posAndUV,numValues,c,true);
+		if(textureEnabled)
+			enableTexture(prevTextureId);
+		else
+			disableTexture();
+		return;
+	}
+	if(textBatch.textureId!=textureId || (textBatch.colors.size()+numVertices)*vertexSize>maxBatchSize){
+		flushTextBatch();
+		textBatch.textureId = textureId;
+	}
+	const float offsetX = static_cast<float>(ctxt.position.x());
+	const float offsetY = static_cast<float>(ctxt.position.y());
+	const size_t first = textBatch.posAndUV.size();
+	textBatch.posAndUV.insert(textBatch.posAndUV.end(),posAndUV,posAndUV+numVertices*4);
+	for(auto it = textBatch.posAndUV.begin()+first; it!=textBatch.posAndUV.end(); it+=4){
+		it[0] += offsetX;
+		it[1] += offsetY;
+	}
+	textBatch.colors.insert(textBatch.colors.end(),numVertices,c.getAsUInt());
+}
+
+//! (static)
+void Draw::flushText(){
+	flushTextBatch();
+}
+
 //! (static)
 float Draw::getTextWidth(const std::string & text, AbstractFont * font){
 	return font == nullptr ? 0 : font->getRenderedTextSize( text ).getWidth();
@@ -710,11 +835,18 @@ void Draw::dropShadow(const Geometry::Rect & r1,const Geometry::Rect & r2, const
 
 //! (static)
 void Draw::drawTexturedTriangles(const std::vector<float> & posAndUV, const Util::Color4ub & c, bool blend/* = true*/){
+	drawTexturedTriangles(posAndUV.data(), posAndUV.size(), c, blend);
+}
+
+//! (static)
+void Draw::drawTexturedTriangles(const float * posAndUV, size_t numValues, const Util::Color4ub & c, bool blend/* = true*/){
+	if(numValues==0)
+		return;
 	if (blend) {
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
 	}
-	drawTexturedVertices(GL_TRIANGLES, posAndUV.size() / (4), posAndUV.data() , c);
+	drawTexturedVertices(GL_TRIANGLES, numValues / (4), posAndUV , c);
 	if (blend)
 		glDisable(GL_BLEND);
 }
@@ -788,6 +920,7 @@ void Draw::drawTriangleFan(const std::vector<float> & vertices,const std::vector
 // texture
 
 void Draw::disableTexture(){
+	ctxt.textureEnabled = false;
 	if(ctxt.useShader){
 		if(ctxt.activeTextureId != ctxt.nullTexture){
 			glBindTexture(GL_TEXTURE_2D,ctxt.nullTexture);
@@ -800,11 +933,14 @@ void Draw::disableTexture(){
 }
 
 void Draw::destroyTexture(uint32_t textureId) {
+	if(textBatch.textureId==textureId)
+		flushTextBatch();
 	GLuint glId = static_cast<GLuint>(textureId);
 	glDeleteTextures(1,&glId);
 }
 	
 void Draw::enableTexture(uint32_t textureId) {
+	ctxt.textureEnabled = true;
 	if(ctxt.useShader){
 		if(ctxt.activeTextureId != textureId){
 			glBindTexture(GL_TEXTURE_2D,textureId);
@@ -837,6 +973,8 @@ uint32_t Draw::generateTextureId(){
 }
 
 void Draw::uploadTexture(uint32_t textureId,uint32_t width,uint32_t height,const Util::PixelFormat & pixelFormat, const uint8_t * data){
+	if(textBatch.textureId==textureId)
+		flushTextBatch();
 
 	GLint glInternalFormat;
 	GLint glFormat;
@@ -872,6 +1010,46 @@ void Draw::uploadTexture(uint32_t textureId,uint32_t width,uint32_t height,const
 	glBindTexture(GL_TEXTURE_2D,ctxt.activeTextureId);
 }
 
+//! (internal) Convert @p count alpha values into white rgba pixels.
+static void expandAlphaToRGBA(const uint8_t * alpha, uint8_t * rgba, size_t count){
+	size_t i = 0;
+#if defined(GUI_DRAW_USE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i white = _mm_set1_epi32(0x00ffffff);
+	for(; i+16<=count; i+=16){
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha+i));
+		const __m128i a16Low = _mm_unpacklo_epi8(zero,a);	// a<<8 (16 bit)
+		const __m128i a16High = _mm_unpackhi_epi8(zero,a);
+		__m128i * out = reinterpret_cast<__m128i*>(rgba+i*4);
+		_mm_storeu_si128(out, _mm_or_si128(white,_mm_unpacklo_epi16(zero,a16Low)));	// a<<24 | 0xffffff (32 bit)
+		_mm_storeu_si128(out+1, _mm_or_si128(white,_mm_unpackhi_epi16(zero,a16Low)));
+		_mm_storeu_si128(out+2, _mm_or_si128(white,_mm_unpacklo_epi16(zero,a16High)));
+		_mm_storeu_si128(out+3, _mm_or_si128(white,_mm_unpackhi_epi16(zero,a16High)));
+	}
+#endif
+	for(; i<count; ++i){
+		rgba[i*4] = rgba[i*4+1] = rgba[i*4+2] = 255;
+		rgba[i*4+3] = alpha[i];
+	}
+}
+
+//! (static)
+void Draw::uploadAlphaTexture(uint32_t textureId,uint32_t width,uint32_t height, const uint8_t * data){
+	if(textBatch.textureId==textureId)
+		flushTextBatch();
+	glBindTexture(GL_TEXTURE_2D,textureId);
+	if(GLEW_VERSION_3_3 || GLEW_ARB_texture_swizzle){
+		glTexImage2D(GL_TEXTURE_2D,0, GL_R8, width,height, /*border*/0, GL_RED, GL_UNSIGNED_BYTE, data);
+		const GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+	}else{
+		std::vector<uint8_t> rgba(static_cast<size_t>(width)*height*4);
+		expandAlphaToRGBA(data, rgba.data(), static_cast<size_t>(width)*height);
+		glTexImage2D(GL_TEXTURE_2D,0, GL_RGBA, width,height, /*border*/0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+	}
+	glBindTexture(GL_TEXTURE_2D,ctxt.activeTextureId);
+}
+
 //----------------------------------------------------------------------------------
 
 
@@ -45,6 +45,13 @@ class Draw {
 		static void drawText(const std::string & text, const Geometry::Rect & r, AbstractFont * font,
 										const Util::Color4ub & c,unsigned int style = TEXT_ALIGN_LEFT | TEXT_ALIGN_MIDDLE);
 										
+		/*! Draw the glyph quads of a text (@p posAndUV as for drawTexturedTriangles(...)) using the given font texture.
+				The quads of consecutive texts using the same texture are collected, even if the cursor has been moved in between,
+				and drawn at once when another texture, another scissor rect or any other drawing function is used.	*/
+		static void drawTextGlyphs(uint32_t textureId, const float * posAndUV, size_t numValues, const Util::Color4ub & c);
+		//! Draw the collected text immediately; required before issuing own OpenGL commands while drawing.
+		static void flushText();
+
 		static float getTextWidth(const std::string & text, AbstractFont * font);
 		static Geometry::Vec2 getTextSize(const std::string & text, AbstractFont * font);
 
@@ -67,6 +74,8 @@ class Draw {
 
 		//! @p posAndUV:  { x0,y0,u0,v0, x1,y1,u1,v1, x2,y2,u2,v2, ... }
 		static void drawTexturedTriangles(const std::vector<float> & posAndUV, const Util::Color4ub & c, bool blend = true);
+		//! @p posAndUV:  { x0,y0,u0,v0, x1,y1,u1,v1, ... }; @p numValues is the number of floats (four per vertex).
+		static void drawTexturedTriangles(const float * posAndUV, size_t numValues, const Util::Color4ub & c, bool blend = true);
 
 		//! @p vertices:  { x0,y0, x1,y1, x2,y2, ... } @p color {c0, c1, c2, ...}
 		static void drawLine(const std::vector<float> & vertices,const std::vector<uint32_t> & colors, const float lineWidth = 1.0,bool lineSmooth=false);
@@ -83,6 +92,9 @@ class Draw {
 		static void disableTexture();
 		static void destroyTexture(uint32_t textureId);
 		static void uploadTexture(uint32_t textureId,uint32_t width,uint32_t height,const Util::PixelFormat & format, const uint8_t * data);
+		/*! Upload single channel 8 bit data (e.g. the coverage of a font atlas) that is sampled as (1,1,1,value).
+			If texture swizzling is not supported, the data is expanded to rgba.	*/
+		static void uploadAlphaTexture(uint32_t textureId,uint32_t width,uint32_t height, const uint8_t * data);
 };
 
 }
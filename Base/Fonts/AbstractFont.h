@@ -35,6 +35,17 @@ class AbstractFont : public Util::ReferenceCounter<AbstractFont> {
 		virtual void renderText( const Geometry::Vec2 & pos, const std::string & text, const Util::Color4ub & color )=0;
 		virtual Geometry::Vec2 getRenderedTextSize( const std::string & text )=0;
 
+		/*! ---o
+			Advance the pen position @p x of a single line (starting at 0) by the characters text[@p begin,@p end) and return
+			the new position; @p prevCodePoint is the code point before @p begin (0 at the beginning of the line) and is updated.
+			This allows measuring a growing line piece by piece instead of measuring each prefix from the beginning.
+			The default implementation measures the piece on its own, so position dependent characters (tabs) and kerning
+			across the pieces are not considered.	*/
+		virtual float advanceText( const std::string & text, size_t begin, size_t end, float x, uint32_t & prevCodePoint ){
+			prevCodePoint = 0;
+			return end>begin ? x + getRenderedTextSize(text.substr(begin,end-begin)).x() : x;
+		}
+
 		uint32_t getLineHeight()const				{	return lineHeight;	}
 
 	private:
@@ -17,28 +17,97 @@
 #include <Util/IO/FileName.h>
 #include <Util/StringUtils.h>
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GUI_BITMAPFONT_USE_MMAP
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GUI_BITMAPFONT_USE_SSE2
+#endif
+
 using namespace Geometry;
 
 namespace GUI {
 
+//! (internal) Returns the length of the leading run of 7-bit ascii characters in @p data.
+static size_t countLeadingAscii(const char * data, size_t length){
+	size_t i = 0;
+#if defined(__AVX2__)
+	for(; i+32<=length; i+=32){
+		if(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+i)))!=0)
+			break; // the remaining bytes of this block are checked below
+	}
+#elif defined(GUI_BITMAPFONT_USE_SSE2)
+	for(; i+16<=length; i+=16){
+		if(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data+i)))!=0)
+			break; // the remaining bytes of this block are checked below
+	}
+#endif
+	while(i<length && (static_cast<uint8_t>(data[i])&0x80)==0)
+		++i;
+	return i;
+}
+
+/*! (internal) Calls @p fun(codePoint) for every code point of the utf8 encoded text[@p begin,@p end).
+	Runs of ascii characters are passed on directly without calling the general utf8 decoder. */
+template<typename fun_t>
+static void forEachCodePoint(const std::string & text, size_t begin, size_t end, fun_t fun){
+	const size_t length = std::min(end,text.length());
+	size_t cursor = begin;
+	while(cursor<length){
+		const size_t asciiEnd = cursor + countLeadingAscii(text.data()+cursor, length-cursor);
+		for(; cursor<asciiEnd; ++cursor)
+			fun(static_cast<uint32_t>(static_cast<uint8_t>(text[cursor])));
+		if(cursor>=length)
+			break;
+		const auto codePoint = Util::StringUtils::readUTF8Codepoint(text,cursor);
+		if(codePoint.second==0) // invalid sequence or end of string
+			break;
+		fun(codePoint.first);
+		cursor += codePoint.second;
+	}
+}
+
+//! (internal) Calls @p fun(codePoint) for every code point of the utf8 encoded @p text.
+template<typename fun_t>
+static void forEachCodePoint(const std::string & text, fun_t fun){
+	forEachCodePoint(text,0,text.length(),fun);
+}
+
+const BitmapFont::Glyph BitmapFont::emptyGlyph;
+
 //! (static) Factory
 Util::Reference<BitmapFont> BitmapFont::createFont(const Util::FileName & fontFile,uint32_t fontSize,const std::string & charMap_utf8){
 	Util::FontRenderer fontRenderer(fontFile.getPath());
 	const auto charMap_utf32 = Util::StringUtils::utf8_to_utf32(charMap_utf8);
 	auto bitmapAndFontInfo = fontRenderer.createGlyphBitmap(fontSize,charMap_utf32);
 	Util::Reference<Util::Bitmap> bitmap = bitmapAndFontInfo.first;
-	if(bitmap->getPixelFormat().getNumComponents()!=4){ // alpha values are required!
+	// Single channel coverage is used directly as alpha-only atlas (a quarter of the size of an rgba atlas);
+	// other formats without alpha values are converted.
+	if(bitmap->getPixelFormat()!=Util::PixelFormat::MONO && bitmap->getPixelFormat().getNumComponents()!=4){
 		const uint32_t width = bitmap->getWidth();
 		const uint32_t height = bitmap->getHeight();
-		Util::Reference<Util::Bitmap> convertedBitmap = new Util::Bitmap(width,height,Util::PixelFormat::RGBA);
+		Util::Reference<Util::Bitmap> convertedBitmap = new Util::Bitmap(width,height,Util::PixelFormat::MONO);
 		
 		Util::Reference<Util::PixelAccessor> reader( Util::PixelAccessor::create(bitmap.get()));
-		Util::Reference<Util::PixelAccessor> writer( Util::PixelAccessor::create(convertedBitmap.get()));
+		uint8_t * alpha = convertedBitmap->data();
 		for(uint32_t y = 0;y<height;++y ){
-			for(uint32_t x = 0;x<width;++x ){
-				const uint8_t alpha = reader->readSingleValueByte(x,y);
-				writer->writeColor(x,y,Util::Color4ub(255,255,255,alpha));
-			}
+			for(uint32_t x = 0;x<width;++x )
+				*alpha++ = reader->readSingleValueByte(x,y);
 		}
 		bitmap = convertedBitmap;
 	}
@@ -64,8 +133,10 @@ Util::Reference<BitmapFont> BitmapFont::createFont(const Util::FileName & fontFi
 
 //!	(ctor)
 BitmapFont::BitmapFont(Util::Reference<ImageData> _bitmap,int _lineHeight):
-		AbstractFont(_lineHeight),bitmap(std::move(_bitmap)),tabWidth(24){
-	//ctor
+		AbstractFont(_lineHeight),bitmap(std::move(_bitmap)),tabWidth(24),
+		textSizeCacheCapacity(1024),textSizeCacheHits(0),textSizeCacheMisses(0){
+	if(bitmap.isNotNull() && bitmap->getPixelFormat()==Util::PixelFormat::MONO)
+		bitmap->setAlphaMask(true);
 }
 
 //!	(dtor)
@@ -75,54 +146,259 @@ BitmapFont::~BitmapFont(){
 
 void BitmapFont::addGlyph(uint32_t characterCode,uint32_t width, uint32_t height, const Geometry::Vec2i & textureOffset,const Geometry::Vec2i & screenOffset, int xAdvance){
 	if(bitmap.isNull()){
-		glyphs.emplace(characterCode, Glyph(xAdvance));
+		addGlyph(characterCode, Glyph(xAdvance));
 	}else{
-		const uint32_t bitmapWidth = bitmap->getBitmap()->getWidth();
-		const uint32_t bitmapHeight = bitmap->getBitmap()->getHeight();
+		const uint32_t bitmapWidth = bitmap->getWidth();
+		const uint32_t bitmapHeight = bitmap->getHeight();
 		const Geometry::Rect uvRect(	static_cast<float>(textureOffset.x()) / bitmapWidth,
 										static_cast<float>(textureOffset.y()) / bitmapHeight,
 										static_cast<float>(width) / bitmapWidth,
 										static_cast<float>(height) / bitmapHeight);
 		const Geometry::Rect_i screenRect(	screenOffset.x(),screenOffset.y(),width,height );
 
-		glyphs.emplace(characterCode, Glyph(uvRect,screenRect,xAdvance));
+		addGlyph(characterCode, Glyph(uvRect,screenRect,xAdvance));
 	}
 }
 
-//!	---|> AbstractFont
-void BitmapFont::enable(){
-	if(bitmap.isNotNull())
-		bitmap->enable();
+void BitmapFont::addGlyph(uint32_t characterCode, const Glyph & glyph){
+	if(characterCode<asciiGlyphs.size()){
+		if(!asciiGlyphs[characterCode].isValid())
+			asciiGlyphs[characterCode] = glyph;
+	}else{
+		glyphs.emplace(characterCode, glyph);
+	}
+	clearTextSizeCache();
+}
+
+// -----------------------------------------------------------------
+// binary font files
+
+/*! (internal) Layout of a binary font file:
+	header | glyph table | kerning table | padding | atlas pixels (aligned to 16 bytes).
+	All values are stored in the byte order of the writing machine.	*/
+struct BinaryFontHeader{
+	char magic[8];				// "GUIFONT\0"
+	uint32_t version;
+	uint32_t byteOrderMark;		// 0x01020304
+	uint32_t lineHeight;
+	uint32_t tabWidth;
+	uint32_t atlasWidth;
+	uint32_t atlasHeight;
+	uint32_t atlasComponents;	// 4: RGBA; 1: MONO
+	uint32_t numGlyphs;
+	uint32_t numKerningPairs;
+	uint32_t glyphOffset;
+	uint32_t kerningOffset;
+	uint32_t atlasOffset;
+};
+struct BinaryFontGlyph{
+	uint32_t codePoint;
+	int32_t screenRect[4];	// x, y, width, height
+	int32_t xAdvance;
+	float uvRect[4];		// x, y, width, height
+};
+struct BinaryFontKerning{
+	uint32_t first;
+	uint32_t second;
+	int32_t amount;
+};
+static const char binaryFontMagic[8] = {'G','U','I','F','O','N','T','\0'};
+static const uint32_t binaryFontVersion = 1;
+static const uint32_t binaryFontByteOrderMark = 0x01020304;
+static const uint32_t binaryFontMaxMetric = 4096;	// upper bound of a plausible lineHeight and tabWidth (in pixels)
+
+//! (internal) Read-only memory mapping of a whole file; where mmap is not available, the file is read into memory.
+class MappedFile{
+		const uint8_t * fileData;
+		size_t fileSize;
+		std::vector<uint8_t> buffer;
+	public:
+		explicit MappedFile(const std::string & path) : fileData(nullptr), fileSize(0){
+#if defined(GUI_BITMAPFONT_USE_MMAP)
+			const int fd = open(path.c_str(),O_RDONLY);
+			if(fd<0)
+				throw std::runtime_error("BitmapFont: Could not open file '"+path+"'.");
+			struct stat fileStat;
+			if(fstat(fd,&fileStat)==0 && fileStat.st_size>0){
+				void * mapping = mmap(nullptr,static_cast<size_t>(fileStat.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+				if(mapping!=MAP_FAILED){
+					fileData = static_cast<const uint8_t*>(mapping);
+					fileSize = static_cast<size_t>(fileStat.st_size);
+				}
+			}
+			close(fd);
+			if(fileData==nullptr)
+				throw std::runtime_error("BitmapFont: Could not map file '"+path+"'.");
+#else
+			std::ifstream in(path,std::ios::binary);
+			if(!in)
+				throw std::runtime_error("BitmapFont: Could not open file '"+path+"'.");
+			buffer.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+			fileData = buffer.data();
+			fileSize = buffer.size();
+#endif
+		}
+		~MappedFile(){
+#if defined(GUI_BITMAPFONT_USE_MMAP)
+			munmap(const_cast<uint8_t*>(fileData),fileSize);
+#endif
+		}
+		MappedFile(const MappedFile &) = delete;
+		MappedFile & operator=(const MappedFile &) = delete;
+
+		const uint8_t * data()const		{	return fileData;	}
+		size_t size()const				{	return fileSize;	}
+};
+
+//! (static)
+Util::Reference<BitmapFont> BitmapFont::loadFont(const Util::FileName & fileName){
+	const std::shared_ptr<const MappedFile> file = std::make_shared<MappedFile>(fileName.getPath());
+	const uint8_t * data = file->data();
+	const uint64_t size = file->size();
+
+	if(size<sizeof(BinaryFontHeader))
+		throw std::runtime_error("BitmapFont::loadFont: Invalid font file '"+fileName.toString()+"'.");
+	const BinaryFontHeader & header = *reinterpret_cast<const BinaryFontHeader*>(data);
+	if(std::memcmp(header.magic,binaryFontMagic,sizeof(binaryFontMagic))!=0)
+		throw std::runtime_error("BitmapFont::loadFont: Invalid font file '"+fileName.toString()+"'.");
+	if(header.version!=binaryFontVersion || header.byteOrderMark!=binaryFontByteOrderMark)
+		throw std::runtime_error("BitmapFont::loadFont: Unsupported version or byte order of font file '"+fileName.toString()+"'.");
+	if(header.atlasComponents!=4 && header.atlasComponents!=1)
+		throw std::runtime_error("BitmapFont::loadFont: Unsupported atlas format in '"+fileName.toString()+"'.");
+	if(	header.lineHeight==0 || header.lineHeight>binaryFontMaxMetric ||
+			header.tabWidth==0 || header.tabWidth>binaryFontMaxMetric )
+		throw std::runtime_error("BitmapFont::loadFont: Invalid line height or tab width in '"+fileName.toString()+"'.");
+	const uint64_t atlasSize = static_cast<uint64_t>(header.atlasWidth)*header.atlasHeight*header.atlasComponents;
+	if(	header.glyphOffset%4!=0 || header.kerningOffset%4!=0 ||
+			header.glyphOffset + static_cast<uint64_t>(header.numGlyphs)*sizeof(BinaryFontGlyph) > size ||
+			header.kerningOffset + static_cast<uint64_t>(header.numKerningPairs)*sizeof(BinaryFontKerning) > size ||
+			header.atlasOffset + atlasSize > size )
+		throw std::runtime_error("BitmapFont::loadFont: Truncated font file '"+fileName.toString()+"'.");
+
+	const Util::PixelFormat & format = header.atlasComponents==4 ? Util::PixelFormat::RGBA : Util::PixelFormat::MONO;
+	Util::Reference<BitmapFont> font = new BitmapFont(new ImageData(header.atlasWidth,header.atlasHeight,format,data+header.atlasOffset,file),
+														header.lineHeight);
+	font->tabWidth = header.tabWidth;
+
+	const BinaryFontGlyph * glyphTable = reinterpret_cast<const BinaryFontGlyph*>(data+header.glyphOffset);
+	font->glyphs.reserve(header.numGlyphs);
+	for(uint32_t i = 0; i<header.numGlyphs; ++i){
+		const BinaryFontGlyph & g = glyphTable[i];
+		font->addGlyph(g.codePoint, Glyph(	Geometry::Rect(g.uvRect[0],g.uvRect[1],g.uvRect[2],g.uvRect[3]),
+												Geometry::Rect_i(g.screenRect[0],g.screenRect[1],g.screenRect[2],g.screenRect[3]),
+												g.xAdvance));
+	}
+	// the kerning table is sorted -> appending to the map takes constant time
+	const BinaryFontKerning * kerningTable = reinterpret_cast<const BinaryFontKerning*>(data+header.kerningOffset);
+	for(uint32_t i = 0; i<header.numKerningPairs; ++i){
+		const BinaryFontKerning & k = kerningTable[i];
+		font->kerning.emplace_hint(font->kerning.end(),std::make_pair(k.first,k.second),static_cast<int16_t>(k.amount));
+	}
+	font->clearTextSizeCache();
+	return font;
+}
+
+void BitmapFont::saveFont(const Util::FileName & fileName)const{
+	if(bitmap.isNull())
+		throw std::invalid_argument("BitmapFont::saveFont: Font has no bitmap.");
+	const Util::Reference<Util::Bitmap> & atlas = bitmap->getBitmap();
+	uint32_t components;
+	if(atlas->getPixelFormat()==Util::PixelFormat::RGBA)
+		components = 4;
+	else if(atlas->getPixelFormat()==Util::PixelFormat::MONO)
+		components = 1;
+	else
+		throw std::invalid_argument("BitmapFont::saveFont: Unsupported atlas format.");
+
+	std::vector<BinaryFontGlyph> glyphTable;
+	glyphTable.reserve(asciiGlyphs.size()+glyphs.size());
+	const auto addRecord = [&glyphTable](uint32_t codePoint,const Glyph & g){
+		const BinaryFontGlyph record = {	codePoint,
+											{ g.screenRect.getX(), g.screenRect.getY(), g.screenRect.getWidth(), g.screenRect.getHeight() },
+											g.xAdvance,
+											{ g.uvRect.getX(), g.uvRect.getY(), g.uvRect.getWidth(), g.uvRect.getHeight() } };
+		glyphTable.push_back(record);
+	};
+	for(uint32_t codePoint = 0; codePoint<asciiGlyphs.size(); ++codePoint){
+		if(asciiGlyphs[codePoint].isValid())
+			addRecord(codePoint,asciiGlyphs[codePoint]);
+	}
+	for(const auto & entry : glyphs)
+		addRecord(entry.first,entry.second);
+	std::sort(glyphTable.begin(),glyphTable.end(),[](const BinaryFontGlyph & a,const BinaryFontGlyph & b){	return a.codePoint<b.codePoint;	});
+
+	std::vector<BinaryFontKerning> kerningTable;
+	kerningTable.reserve(kerning.size());
+	for(const auto & entry : kerning){ // std::map -> sorted
+		const BinaryFontKerning record = { entry.first.first, entry.first.second, entry.second };
+		kerningTable.push_back(record);
+	}
+
+	BinaryFontHeader header;
+	std::memcpy(header.magic,binaryFontMagic,sizeof(binaryFontMagic));
+	header.version = binaryFontVersion;
+	header.byteOrderMark = binaryFontByteOrderMark;
+	header.lineHeight = getLineHeight();
+	header.tabWidth = tabWidth;
+	header.atlasWidth = atlas->getWidth();
+	header.atlasHeight = atlas->getHeight();
+	header.atlasComponents = components;
+	header.numGlyphs = static_cast<uint32_t>(glyphTable.size());
+	header.numKerningPairs = static_cast<uint32_t>(kerningTable.size());
+	header.glyphOffset = sizeof(BinaryFontHeader);
+	header.kerningOffset = header.glyphOffset + header.numGlyphs*sizeof(BinaryFontGlyph);
+	header.atlasOffset = (header.kerningOffset + header.numKerningPairs*sizeof(BinaryFontKerning) + 15) & ~15u;
+	const size_t atlasSize = static_cast<size_t>(header.atlasWidth)*header.atlasHeight*components;
+	const size_t padding = header.atlasOffset - (header.kerningOffset + header.numKerningPairs*sizeof(BinaryFontKerning));
+
+	std::ofstream out(fileName.getPath(),std::ios::binary|std::ios::trunc);
+	if(!out)
+		throw std::runtime_error("BitmapFont::saveFont: Could not open file '"+fileName.toString()+"'.");
+	static const char zeros[16] = {};
+	out.write(reinterpret_cast<const char*>(&header),sizeof(header));
+	out.write(reinterpret_cast<const char*>(glyphTable.data()),glyphTable.size()*sizeof(BinaryFontGlyph));
+	out.write(reinterpret_cast<const char*>(kerningTable.data()),kerningTable.size()*sizeof(BinaryFontKerning));
+	out.write(zeros,padding);
+	out.write(reinterpret_cast<const char*>(atlas->data()),std::min(atlasSize,atlas->getDataSize()));
+	if(!out)
+		throw std::runtime_error("BitmapFont::saveFont: Could not write file '"+fileName.toString()+"'.");
 }
 
 //!	---|> AbstractFont
-void BitmapFont::disable(){
+void BitmapFont::enable(){
 	if(bitmap.isNotNull())
-		bitmap->disable();
+		bitmap->prepareGLTexture();
 }
 
 //!	---|> AbstractFont
 void BitmapFont::renderText( const Vec2 & _pos, const std::string & text, const Util::Color4ub & color){
-	std::vector<float> posAndUV;
-	posAndUV.reserve(text.length()*24);
+	// reserve the vertex data (six vertices per byte) for at most maxGlyphsPerChunk glyphs and write it directly;
+	// longer texts are passed to Draw::drawTextGlyphs(...) in several chunks.
+	static const size_t maxGlyphsPerChunk = 256;
+	const size_t chunkSize = std::min(text.length(),maxGlyphsPerChunk)*24;
+	if(posAndUV.size()<chunkSize)
+		posAndUV.resize(chunkSize);
+	float * out = posAndUV.data();
+	const uint32_t textureId = bitmap.isNotNull() ? bitmap->prepareGLTexture() : 0;
+	const auto emitChunk = [&](){
+		if(textureId!=0)
+			Draw::drawTextGlyphs(textureId,posAndUV.data(),static_cast<size_t>(out-posAndUV.data()),color);
+		out = posAndUV.data();
+	};
 
 	Vec2 pos(round(_pos.getX()),round(_pos.getY()));
+	const bool hasKerning = !kerning.empty();
 	
 	uint32_t prevChar = 0;
-	size_t cursor = 0;
-	while(true){
-		auto codePoint = Util::StringUtils::readUTF8Codepoint(text,cursor);
-		if(codePoint.second==0) // end of string
-			break;
-
-		if(codePoint.first==static_cast<uint32_t>('\n')){
+	forEachCodePoint(text,[&](uint32_t codePoint){
+		if(codePoint==static_cast<uint32_t>('\n')){
 			pos.setY(pos.getY()+getLineHeight());
 			pos.setX(_pos.getX());
 		}else{
-			const Glyph & type = getGlyph(codePoint.first);
+			const Glyph & type = getGlyph(codePoint);
 			float dx = 0;
 			if(!type.isValid()){
-				if( codePoint.first == static_cast<uint32_t>('\t') ){ // tab
+				if( codePoint == static_cast<uint32_t>('\t') ){ // tab
 					dx = tabWidth - static_cast<int>(pos.x() - _pos.x())%tabWidth;
 				}else{
 					const Geometry::Rect r(static_cast<int>(pos.getX()+1) , static_cast<int>(pos.getY()+1) , 5, getLineHeight()-1);
@@ -130,37 +406,87 @@ void BitmapFont::renderText( const Vec2 & _pos, const std::string & text, const
 					dx = 7.0;
 				}
 			}else{
-				const auto kerningIt( kerning.find(std::make_pair(prevChar,codePoint.first)) );
-				if(kerningIt!=kerning.end())
-					pos.x( pos.x()+kerningIt->second );
-				const Geometry::Rect rect = Geometry::Rect(
-												static_cast<int>(pos.getX()) + type.screenRect.getX() ,
-												static_cast<int>(pos.getY()) + type.screenRect.getY() ,
-												type.screenRect.getWidth() ,
-												type.screenRect.getHeight());
-
-				posAndUV.push_back(rect.getMinX());	posAndUV.push_back(rect.getMaxY());	posAndUV.push_back(type.uvRect.getMinX());	posAndUV.push_back(type.uvRect.getMaxY());
-				posAndUV.push_back(rect.getMaxX());	posAndUV.push_back(rect.getMaxY());	posAndUV.push_back(type.uvRect.getMaxX());	posAndUV.push_back(type.uvRect.getMaxY());
-				posAndUV.push_back(rect.getMaxX());	posAndUV.push_back(rect.getMinY());	posAndUV.push_back(type.uvRect.getMaxX());	posAndUV.push_back(type.uvRect.getMinY());
-
-				posAndUV.push_back(rect.getMaxX());	posAndUV.push_back(rect.getMinY());	posAndUV.push_back(type.uvRect.getMaxX());	posAndUV.push_back(type.uvRect.getMinY());
-				posAndUV.push_back(rect.getMinX());	posAndUV.push_back(rect.getMinY());	posAndUV.push_back(type.uvRect.getMinX());	posAndUV.push_back(type.uvRect.getMinY());
-				posAndUV.push_back(rect.getMinX());	posAndUV.push_back(rect.getMaxY());	posAndUV.push_back(type.uvRect.getMinX());	posAndUV.push_back(type.uvRect.getMaxY());
+				if(hasKerning){
+					const auto kerningIt( kerning.find(std::make_pair(prevChar,codePoint)) );
+					if(kerningIt!=kerning.end())
+						pos.x( pos.x()+kerningIt->second );
+				}
+				const float minX = static_cast<int>(pos.getX()) + type.screenRect.getX();
+				const float minY = static_cast<int>(pos.getY()) + type.screenRect.getY();
+				const float maxX = minX + type.screenRect.getWidth();
+				const float maxY = minY + type.screenRect.getHeight();
+				const float minU = type.uvRect.getMinX();
+				const float minV = type.uvRect.getMinY();
+				const float maxU = type.uvRect.getMaxX();
+				const float maxV = type.uvRect.getMaxY();
+
+				out[0] = minX;	out[1] = maxY;	out[2] = minU;	out[3] = maxV;
+				out[4] = maxX;	out[5] = maxY;	out[6] = maxU;	out[7] = maxV;
+				out[8] = maxX;	out[9] = minY;	out[10] = maxU;	out[11] = minV;
+
+				out[12] = maxX;	out[13] = minY;	out[14] = maxU;	out[15] = minV;
+				out[16] = minX;	out[17] = minY;	out[18] = minU;	out[19] = minV;
+				out[20] = minX;	out[21] = maxY;	out[22] = minU;	out[23] = maxV;
+				out += 24;
+				if(out==posAndUV.data()+chunkSize)
+					emitChunk();
 
 				dx = type.xAdvance;
 			}
 			pos.setX(pos.getX()+dx);
 		}
-		
-		cursor += codePoint.second;
-		prevChar = codePoint.first;
-	}
-
-	Draw::drawTexturedTriangles(posAndUV,color,true);
+		prevChar = codePoint;
+	});
+	emitChunk();
 }
 
 //!	---|> AbstractFont
 Vec2 BitmapFont::getRenderedTextSize( const std::string & text ){
+	std::unique_lock<std::mutex> lock(textSizeCacheMutex);
+	if(textSizeCacheCapacity==0 || text.length()>MAX_CACHED_TEXT_LENGTH){
+		++textSizeCacheMisses;
+		lock.unlock();
+		return calculateRenderedTextSize(text);
+	}
+	auto it = textSizeCacheIndex.find(text);
+	if(it!=textSizeCacheIndex.end()){
+		++textSizeCacheHits;
+		// move the entry to the front of the lru list
+		textSizeCacheEntries.splice(textSizeCacheEntries.begin(),textSizeCacheEntries,it->second);
+		return it->second->second;
+	}
+	++textSizeCacheMisses;
+	lock.unlock();
+	const Vec2 size = calculateRenderedTextSize(text);
+	lock.lock();
+	if(textSizeCacheIndex.count(text)>0 || textSizeCacheCapacity==0) // added by another thread in the meantime
+		return size;
+	if(textSizeCacheIndex.size()>=textSizeCacheCapacity){
+		textSizeCacheIndex.erase(textSizeCacheEntries.back().first);
+		textSizeCacheEntries.pop_back();
+	}
+	textSizeCacheEntries.emplace_front(text,size);
+	textSizeCacheIndex.emplace(text,textSizeCacheEntries.begin());
+	return size;
+}
+
+void BitmapFont::clearTextSizeCache(){
+	std::lock_guard<std::mutex> lock(textSizeCacheMutex);
+	textSizeCacheIndex.clear();
+	textSizeCacheEntries.clear();
+}
+
+void BitmapFont::setTextSizeCacheCapacity(size_t capacity){
+	std::lock_guard<std::mutex> lock(textSizeCacheMutex);
+	textSizeCacheCapacity = capacity;
+	while(textSizeCacheIndex.size()>textSizeCacheCapacity){
+		textSizeCacheIndex.erase(textSizeCacheEntries.back().first);
+		textSizeCacheEntries.pop_back();
+	}
+}
+
+//! (internal)
+Vec2 BitmapFont::calculateRenderedTextSize( const std::string & text )const{
 	float maxX = 0;
 	float x = 0;
 	float y = 0;
@@ -169,34 +495,43 @@ Vec2 BitmapFont::getRenderedTextSize( const std::string & text ){
 		y=getLineHeight();
 	
 	uint32_t prevChar = 0;
-	size_t cursor = 0;
-	while(true){
-		auto codePoint = Util::StringUtils::readUTF8Codepoint(text,cursor);
-		if(codePoint.second==0) // end of string
-			break;
-	
-		if(codePoint.first==static_cast<uint32_t>('\n')){
+	forEachCodePoint(text,[&](uint32_t codePoint){
+		if(codePoint==static_cast<uint32_t>('\n')){
 			y += getLineHeight();
 			x = 0;
 		}else{
-			const auto kerningIt( kerning.find(std::make_pair(prevChar,codePoint.first)) );
-			if(kerningIt!=kerning.end())
-				x+=kerningIt->second;
-			const Glyph & type=getGlyph(codePoint.first);
-			if(type.isValid()){
-				x += type.xAdvance;
-			}else if( codePoint.first == static_cast<uint32_t>('\t') ){ // tab
-				x += tabWidth - (static_cast<int>(x)%tabWidth);
-			}else{
-				x+=6.0f;
-			}
-
+			x = advance(x,prevChar,codePoint);
 			if(x>maxX) maxX = x;
 		}
-		cursor += codePoint.second;
-		prevChar = codePoint.first;
-	}
+		prevChar = codePoint;
+	});
 	return Vec2(maxX,y);
 }
 
+//! (internal)
+float BitmapFont::advance(float x, uint32_t prevCodePoint, uint32_t codePoint)const{
+	if(!kerning.empty()){
+		const auto kerningIt( kerning.find(std::make_pair(prevCodePoint,codePoint)) );
+		if(kerningIt!=kerning.end())
+			x+=kerningIt->second;
+	}
+	const Glyph & type=getGlyph(codePoint);
+	if(type.isValid()){
+		return x + type.xAdvance;
+	}else if( codePoint == static_cast<uint32_t>('\t') ){ // tab
+		return x + tabWidth - (static_cast<int>(x)%tabWidth);
+	}else{
+		return x + 6.0f;
+	}
+}
+
+//!	---|> AbstractFont
+float BitmapFont::advanceText( const std::string & text, size_t begin, size_t end, float x, uint32_t & prevCodePoint ){
+	forEachCodePoint(text,begin,end,[&](uint32_t codePoint){
+		x = advance(x,prevCodePoint,codePoint);
+		prevCodePoint = codePoint;
+	});
+	return x;
+}
+
 }
@@ -15,8 +15,11 @@
 #include "AbstractFont.h"
 #include <Geometry/Rect.h>
 
+#include <array>
 #include <unordered_map>
+#include <list>
 #include <map>
+#include <mutex>
 
 namespace Util {
 class FileName;
@@ -32,6 +35,17 @@ class BitmapFont : public AbstractFont{
 		/*! Load a .ttf or .otf file.
 			Returns a BitmapFont or throws an exception.	*/
 		static Util::Reference<BitmapFont> createFont(const Util::FileName & fontFile,uint32_t fontSize,const std::string & charMap_utf8);
+
+		/*! Load a binary font file written by saveFont(...).
+			The file is memory mapped; the glyph and kerning tables are used as stored and the
+			atlas is uploaded directly from the mapped pages.
+			Returns a BitmapFont or throws an exception.	*/
+		static Util::Reference<BitmapFont> loadFont(const Util::FileName & file);
+
+		/*! Write the atlas, the glyphs and the kerning of the font into a binary font file.
+			\note The file uses the byte order of the writing machine.
+			Throws an exception on failure.	*/
+		void saveFont(const Util::FileName & file)const;
 		
 		/*
 			+cursor(0,0)                       _
@@ -74,29 +88,71 @@ class BitmapFont : public AbstractFont{
 		virtual ~BitmapFont();
 
 		void addGlyph(uint32_t characterCode,uint32_t width, uint32_t height, const Geometry::Vec2i & textureOffset, const Geometry::Vec2i & screenOffset, int xAdvance);
+		//! Add a glyph with a precalculated uv rect; an existing glyph for the same character is not replaced.
+		void addGlyph(uint32_t characterCode, const Glyph & glyph);
 		
 		const Glyph & getGlyph(uint32_t characterCode)const{
-			static const Glyph emptyGlyph;
+			if(characterCode<asciiGlyphs.size())
+				return asciiGlyphs[characterCode];
 			const auto it = glyphs.find(characterCode);
 			return it == glyphs.end() ? emptyGlyph : it->second;
 		}
 		const Util::Reference<Util::Bitmap> & getBitmap() const {
 			return bitmap->getBitmap();
 		}
-		void setKerning(uint32_t first,uint32_t second, int16_t amount){	kerning[std::make_pair(first,second)] = amount;	}
-		void setTabWidth(uint32_t s){	tabWidth = s;}
+		void setKerning(uint32_t first,uint32_t second, int16_t amount){	kerning[std::make_pair(first,second)] = amount;	clearTextSizeCache();	}
+		void setTabWidth(uint32_t s){	tabWidth = s;	clearTextSizeCache();	}
 		
 		// ---|> AbstractFont
+		//! Uploads the atlas if necessary; the texture itself is bound when the text is drawn (see Draw::drawTextGlyphs).
 		virtual void enable() override;
-		virtual void disable() override;
 		virtual void renderText(const Geometry::Vec2 & pos, const std::string & text, const Util::Color4ub & color) override;
 		virtual Geometry::Vec2 getRenderedTextSize( const std::string & text) override;
+		//! Does not use the text size cache.
+		virtual float advanceText( const std::string & text, size_t begin, size_t end, float x, uint32_t & prevCodePoint ) override;
 
 	private:
 		std::map<std::pair<uint32_t,uint32_t>, int16_t> kerning; // use std::map instead of unordered map to allow pair as key.
 		Util::Reference<ImageData> bitmap;
-		typefaceMap_t glyphs;
+		typefaceMap_t glyphs; // characters >= 128
 		uint32_t tabWidth;
+
+		static const Glyph emptyGlyph;
+		//! Glyphs of the 7-bit ascii characters; they are stored directly instead of in glyphs.
+		std::array<Glyph,128> asciiGlyphs;
+		//! Reused vertex data of renderText(...) to avoid an allocation per call; it holds at most one chunk of glyphs.
+		std::vector<float> posAndUV;
+
+		Geometry::Vec2 calculateRenderedTextSize( const std::string & text)const;
+		//! The pen position after the code point @p codePoint (following @p prevCodePoint) starting at @p x.
+		float advance(float x, uint32_t prevCodePoint, uint32_t codePoint)const;
+
+	/*!	@name Text size cache
+		The results of getRenderedTextSize(...) are memoized in a bounded least-recently-used cache.
+		The cache is cleared whenever a glyph, the kerning or the tab width is changed.
+		The cache is synchronized, as texts are measured by the parallel layout as well.	*/
+	//	@{
+	public:
+		//! Texts longer than this (in bytes) are always measured directly.
+		static const size_t MAX_CACHED_TEXT_LENGTH = 256;
+
+		void clearTextSizeCache();
+		size_t getTextSizeCacheCapacity()const		{	return textSizeCacheCapacity;	}
+		size_t getTextSizeCacheHits()const			{	return textSizeCacheHits;	}
+		size_t getTextSizeCacheMisses()const		{	return textSizeCacheMisses;	}
+		size_t getTextSizeCacheSize()const			{	return textSizeCacheIndex.size();	}
+		void resetTextSizeCacheCounters()			{	textSizeCacheHits = textSizeCacheMisses = 0;	}
+		//! Set the maximum number of cached entries; 0 disables the cache.
+		void setTextSizeCacheCapacity(size_t capacity);
+	private:
+		typedef std::list<std::pair<std::string,Geometry::Vec2>> textSizeCacheList_t; // most recently used first
+		textSizeCacheList_t textSizeCacheEntries;
+		std::unordered_map<std::string,textSizeCacheList_t::iterator> textSizeCacheIndex;
+		size_t textSizeCacheCapacity;
+		size_t textSizeCacheHits;
+		size_t textSizeCacheMisses;
+		std::mutex textSizeCacheMutex;
+	//	@}
 };
 }
 
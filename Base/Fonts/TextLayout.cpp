@@ -0,0 +1,220 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "TextLayout.h"
+#include <Util/StringUtils.h>
+#include <iterator>
+
+namespace GUI {
+
+//! (internal)
+static bool isWhitespace(char c){
+	return c==' ' || c=='\t';
+}
+
+//! (internal)
+static size_t getNextCodePointPos(const std::string & text, size_t pos){
+	const size_t length = Util::StringUtils::readUTF8Codepoint(text,pos).second;
+	return std::min(text.length(), pos + std::max(static_cast<size_t>(1),length));
+}
+
+//! (static)
+TextLayout::lines_t TextLayout::breakParagraph(AbstractFont * font, float maxWidth, const std::string & paragraph, float * naturalWidth){
+	lines_t lines;
+	uint32_t prevCodePoint = 0;
+	const float fullWidth = font==nullptr ? 0.0f : font->advanceText(paragraph,0,paragraph.length(),0.0f,prevCodePoint);
+	if(naturalWidth!=nullptr)
+		*naturalWidth = fullWidth;
+	if(font==nullptr || maxWidth<=0 || fullWidth<=maxWidth){
+		lines.emplace_back(0,paragraph.length(),fullWidth);
+		return lines;
+	}
+
+	// The lines are measured incrementally (see AbstractFont::advanceText(...)): each piece continues at the pen position
+	// of the previous one, which also places the tabs correctly.
+	const size_t length = paragraph.length();
+	size_t lineBegin = 0;
+	while(lineBegin<length){
+		// add words (including their preceding whitespace) as long as they fit
+		size_t lineEnd = lineBegin;
+		float lineWidth = 0;
+		uint32_t lineEndCodePoint = 0;
+		size_t cursor = lineBegin;
+		while(cursor<length){
+			size_t wordEnd = cursor;
+			while(wordEnd<length && isWhitespace(paragraph[wordEnd]))
+				++wordEnd;
+			while(wordEnd<length && !isWhitespace(paragraph[wordEnd]))
+				++wordEnd;
+			prevCodePoint = lineEndCodePoint;
+			const float width = font->advanceText(paragraph,cursor,wordEnd,lineWidth,prevCodePoint);
+			if(width>maxWidth)
+				break;
+			lineEnd = cursor = wordEnd;
+			lineWidth = width;
+			lineEndCodePoint = prevCodePoint;
+		}
+		if(lineEnd==lineBegin){ // the first word is too wide -> break between the characters that fit (at least one)
+			lineEnd = getNextCodePointPos(paragraph,lineBegin);
+			lineWidth = font->advanceText(paragraph,lineBegin,lineEnd,0.0f,lineEndCodePoint);
+			while(lineEnd<length && !isWhitespace(paragraph[lineEnd])){
+				const size_t next = getNextCodePointPos(paragraph,lineEnd);
+				prevCodePoint = lineEndCodePoint;
+				const float width = font->advanceText(paragraph,lineEnd,next,lineWidth,prevCodePoint);
+				if(width>maxWidth)
+					break;
+				lineEnd = next;
+				lineWidth = width;
+				lineEndCodePoint = prevCodePoint;
+			}
+		}
+		lines.emplace_back(lineBegin,lineEnd,lineWidth);
+		// skip the whitespace at the soft break
+		lineBegin = lineEnd;
+		while(lineBegin<length && isWhitespace(paragraph[lineBegin]))
+			++lineBegin;
+	}
+	return lines;
+}
+
+//! (static)
+std::vector<std::string> TextLayout::splitParagraphs(const std::string & text){
+	std::vector<std::string> result;
+	size_t begin = 0;
+	while(true){
+		const size_t end = text.find('\n',begin);
+		if(end==std::string::npos){
+			result.emplace_back(text.substr(begin));
+			return result;
+		}
+		result.emplace_back(text.substr(begin,end-begin));
+		begin = end+1;
+	}
+}
+
+//! (ctor)
+TextLayout::TextLayout() :
+		maxWidth(0), numberOfRows(0), dirtyBegin(0), dirtyEnd(0), firstDirtyRow(ROWS_VALID) {
+}
+
+void TextLayout::setFont(AbstractFont * newFont){
+	if(font.get()!=newFont){
+		font = newFont;
+		invalidateParagraphs(0,paragraphs.size());
+	}
+}
+
+void TextLayout::setMaxWidth(float newMaxWidth){
+	if(newMaxWidth==maxWidth)
+		return;
+	maxWidth = newMaxWidth;
+	// paragraphs consisting of a single line remain valid if they still fit
+	for(size_t i = 0; i<paragraphs.size(); ++i){
+		Paragraph & paragraph = paragraphs[i];
+		if(paragraph.valid && !(paragraph.lines.size()==1 && (maxWidth<=0 || paragraph.naturalWidth<=maxWidth))){
+			paragraph.valid = false;
+			markDirty(i,i+1);
+		}
+	}
+}
+
+void TextLayout::reset(size_t numberOfParagraphs){
+	paragraphs.clear();
+	paragraphs.resize(numberOfParagraphs);
+	numberOfRows = 0;
+	markDirty(0,numberOfParagraphs);
+	firstDirtyRow = 0;
+}
+
+void TextLayout::insertParagraphs(size_t first, size_t number){
+	first = std::min(first,paragraphs.size());
+	paragraphs.insert(std::next(paragraphs.begin(),first),number,Paragraph());
+	if(dirtyEnd>first)
+		dirtyEnd += number;
+	markDirty(first,first+number);
+	firstDirtyRow = std::min(firstDirtyRow,first);
+}
+
+void TextLayout::eraseParagraphs(size_t first, size_t number){
+	if(first>=paragraphs.size())
+		return;
+	const size_t end = std::min(paragraphs.size(),first+number);
+	paragraphs.erase(std::next(paragraphs.begin(),first),std::next(paragraphs.begin(),end));
+	// the dirty paragraphs behind the erased ones move down
+	const size_t numErased = end-first;
+	dirtyBegin = dirtyBegin>=end ? dirtyBegin-numErased : std::min(dirtyBegin,first);
+	dirtyEnd = dirtyEnd>=end ? dirtyEnd-numErased : std::min(dirtyEnd,first);
+	firstDirtyRow = std::min(firstDirtyRow,first);
+}
+
+void TextLayout::invalidateParagraphs(size_t first, size_t last){
+	if(paragraphs.empty())
+		return;
+	last = std::min(last,paragraphs.size()-1);
+	if(first>last)
+		return;
+	for(size_t i = first; i<=last; ++i)
+		paragraphs[i].valid = false;
+	markDirty(first,last+1);
+}
+
+size_t TextLayout::getLineIndex(size_t paragraph, size_t pos)const{
+	const lines_t & lines = getLines(paragraph);
+	size_t index = 0;
+	while(index+1<lines.size() && lines[index+1].begin<=pos)
+		++index;
+	return index;
+}
+
+std::pair<size_t,size_t> TextLayout::getParagraphAtRow(size_t row)const{
+	if(row>=numberOfRows)
+		return std::make_pair(paragraphs.size(),0);
+	const auto it = std::upper_bound(paragraphs.begin(),paragraphs.end(),row,
+									[](size_t r,const Paragraph & p){	return r<p.firstRow;	});
+	const size_t index = std::distance(paragraphs.begin(),it)-1;
+	return std::make_pair(index,row-paragraphs[index].firstRow);
+}
+
+//! (internal)
+void TextLayout::markDirty(size_t first, size_t end){
+	if(first>=end)
+		return;
+	dirtyBegin = std::min(dirtyBegin,first);
+	dirtyEnd = std::max(dirtyEnd,end);
+}
+
+//! (internal)
+void TextLayout::layoutParagraph(size_t index, const std::string & text){
+	Paragraph & paragraph = paragraphs[index];
+	const size_t oldNumberOfLines = paragraph.lines.size();
+	paragraph.lines = breakParagraph(font.get(),maxWidth,text,&paragraph.naturalWidth);
+	paragraph.valid = true;
+	if(paragraph.lines.size()!=oldNumberOfLines) // the following rows move
+		firstDirtyRow = std::min(firstDirtyRow,index+1);
+}
+
+//! (internal)
+void TextLayout::updateRows(){
+	if(firstDirtyRow==ROWS_VALID)
+		return;
+	size_t row = 0;
+	if(firstDirtyRow>0 && firstDirtyRow<=paragraphs.size()){
+		const Paragraph & prev = paragraphs[firstDirtyRow-1];
+		row = prev.firstRow + prev.lines.size();
+	}
+	for(size_t i = std::min(firstDirtyRow,paragraphs.size()); i<paragraphs.size(); ++i){
+		paragraphs[i].firstRow = row;
+		row += paragraphs[i].lines.size();
+	}
+	numberOfRows = paragraphs.empty() ? 0 : paragraphs.back().firstRow + paragraphs.back().lines.size();
+	firstDirtyRow = ROWS_VALID;
+}
+
+}
@@ -0,0 +1,126 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_TEXT_LAYOUT_H
+#define GUI_TEXT_LAYOUT_H
+
+#include "AbstractFont.h"
+#include <Util/References.h>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GUI {
+
+/***
+ **	TextLayout
+ **	Word wrapping of a text consisting of several paragraphs (the text between two '\n').
+ **	The text itself is not stored: the owner reports changes of its paragraphs
+ **	(insertParagraphs, eraseParagraphs, invalidateParagraphs) and passes the paragraphs
+ **	to update(...), which only breaks the paragraphs that have been changed since the last call.
+ **	The line breaks are kept for the current maximum width. If the width changes, only the
+ **	paragraphs that do not fit into a single line of the new width are broken again.
+ **/
+class TextLayout{
+	public:
+		struct Line{
+			size_t begin;	//!< byte offset of the line inside its paragraph
+			size_t end;		//!< byte offset behind the last visible character (whitespace at a soft break is excluded)
+			float width;
+
+			Line(size_t _begin, size_t _end, float _width) : begin(_begin), end(_end), width(_width) {}
+		};
+		typedef std::vector<Line> lines_t;
+
+		/*! Break a single paragraph (not containing '\n') into lines not wider than @p maxWidth.
+			Lines are broken at whitespace; words wider than @p maxWidth are broken between two characters.
+			If @p maxWidth is <= 0, the paragraph is not wrapped. Each paragraph has at least one line.
+			@param naturalWidth if not null, the width of the unwrapped paragraph is stored there.	*/
+		static lines_t breakParagraph(AbstractFont * font, float maxWidth, const std::string & paragraph, float * naturalWidth = nullptr);
+
+		//! Split @p text at '\n' into paragraphs.
+		static std::vector<std::string> splitParagraphs(const std::string & text);
+
+		TextLayout();
+
+		AbstractFont * getFont()const				{	return font.get();	}
+		//! Changing the font invalidates all paragraphs.
+		void setFont(AbstractFont * newFont);
+
+		float getMaxWidth()const					{	return maxWidth;	}
+		//! A width <= 0 disables wrapping.
+		void setMaxWidth(float newMaxWidth);
+
+	/*!	@name Paragraphs
+		These functions have to be called by the owner of the text whenever its paragraphs change.	*/
+	//	@{
+		size_t getNumberOfParagraphs()const			{	return paragraphs.size();	}
+		//! Discard all line breaks and set the number of (invalid) paragraphs.
+		void reset(size_t numberOfParagraphs);
+		void insertParagraphs(size_t first, size_t number);
+		void eraseParagraphs(size_t first, size_t number);
+		//! Mark the paragraphs [first,last] as changed.
+		void invalidateParagraphs(size_t first, size_t last);
+		bool needsUpdate()const						{	return dirtyBegin<dirtyEnd || firstDirtyRow!=ROWS_VALID;	}
+
+		/*! Break all changed paragraphs and update the row numbers.
+			@param getParagraph function object returning the text of the paragraph with the given index.	*/
+		template<typename getParagraph_t>
+		void update(getParagraph_t getParagraph){
+			const size_t end = std::min(dirtyEnd,paragraphs.size());
+			for(size_t i = dirtyBegin; i<end; ++i){
+				if(!paragraphs[i].valid)
+					layoutParagraph(i,getParagraph(i));
+			}
+			dirtyBegin = paragraphs.size();
+			dirtyEnd = 0;
+			updateRows();
+		}
+	//	@}
+
+	/*!	@name Queries
+		The results are only valid after update(...) has been called.	*/
+	//	@{
+		const lines_t & getLines(size_t paragraph)const		{	return paragraphs.at(paragraph).lines;	}
+		//! Returns the (visual) row of the first line of the given paragraph; for paragraph==getNumberOfParagraphs() the number of rows.
+		size_t getFirstRow(size_t paragraph)const			{	return paragraph<paragraphs.size() ? paragraphs[paragraph].firstRow : numberOfRows;	}
+		size_t getNumberOfRows()const						{	return numberOfRows;	}
+		//! Returns the index of the line inside the given paragraph containing the byte offset @p pos.
+		size_t getLineIndex(size_t paragraph, size_t pos)const;
+		//! Returns (paragraph, line index) of the given row; for rows beyond the text (getNumberOfParagraphs(),0).
+		std::pair<size_t,size_t> getParagraphAtRow(size_t row)const;
+	//	@}
+
+	private:
+		struct Paragraph{
+			lines_t lines;
+			float naturalWidth;
+			size_t firstRow;
+			bool valid;
+			Paragraph() : naturalWidth(0), firstRow(0), valid(false) {}
+		};
+		std::vector<Paragraph> paragraphs;
+		Util::Reference<AbstractFont> font;
+		float maxWidth;
+		size_t numberOfRows;
+		size_t dirtyBegin, dirtyEnd;	//!< range of paragraphs that may be invalid
+		size_t firstDirtyRow;			//!< first paragraph whose firstRow has to be recalculated
+		static const size_t ROWS_VALID = static_cast<size_t>(-1);
+
+		void markDirty(size_t first, size_t end);
+		void layoutParagraph(size_t index, const std::string & text);
+		void updateRows();
+};
+
+}
+
+#endif // GUI_TEXT_LAYOUT_H
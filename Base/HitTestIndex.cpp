@@ -0,0 +1,162 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "HitTestIndex.h"
+#include "../Components/Container.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GUI {
+
+//! Upper bound for the number of cells per axis.
+static const uint32_t MAX_CELLS_PER_AXIS = 256;
+//! Desired average number of entries per cell.
+static const size_t ENTRIES_PER_CELL = 4;
+
+bool HitTestIndex::isValid()const{
+	return root!=nullptr && root->getFlag(Component::HIT_TEST_INDEX_VALID);
+}
+
+Component * HitTestIndex::getComponentAtPos(const Geometry::Vec2 & pos){
+	if(!isValid()){
+		if(queriesUntilRebuild>0){
+			--queriesUntilRebuild;
+			return root->getComponentAtPos(pos);
+		}
+		if(rebuiltForLastQuery){ // invalidated before being reused -> postpone the next rebuild
+			rebuildDelay = rebuildDelay==0 ? 1 : (rebuildDelay*2<MAX_REBUILD_DELAY ? rebuildDelay*2 : MAX_REBUILD_DELAY);
+			queriesUntilRebuild = rebuildDelay-1;
+			rebuiltForLastQuery = false;
+			return root->getComponentAtPos(pos);
+		}
+		rebuild();
+		rebuiltForLastQuery = true;
+	}else{
+		rebuiltForLastQuery = false;
+		rebuildDelay = 0;
+	}
+	if(entries.empty() || pos.x()<minX || pos.x()>maxX || pos.y()<minY || pos.y()>maxY)
+		return nullptr;
+	const uint32_t cell = getCellY(pos.y())*cellsX + getCellX(pos.x());
+	for(uint32_t i = cellBegin[cell+1]; i>cellBegin[cell]; ){ // front to back
+		const Entry & entry = entries[cellEntries[--i]];
+		if(pos.x()>=entry.minX && pos.x()<=entry.maxX && pos.y()>=entry.minY && pos.y()<=entry.maxY && isHit(entry.component,pos))
+			return entry.component;
+	}
+	return nullptr;
+}
+
+void HitTestIndex::rebuild(){
+	entries.clear();
+	cellEntries.clear();
+	cellBegin.assign(1,0);
+	cellsX = cellsY = 0;
+	if(root==nullptr)
+		return;
+	const float inf = std::numeric_limits<float>::max();
+	collect(*root,-inf,-inf,inf,inf);
+	if(entries.empty())
+		return;
+
+	minX = minY = inf;
+	maxX = maxY = -inf;
+	for(const auto & entry : entries){
+		minX = std::min(minX,entry.minX);
+		minY = std::min(minY,entry.minY);
+		maxX = std::max(maxX,entry.maxX);
+		maxY = std::max(maxY,entry.maxY);
+	}
+	const float width = std::max(maxX-minX,1.0f);
+	const float height = std::max(maxY-minY,1.0f);
+	const float numCells = static_cast<float>(std::max(static_cast<size_t>(1),entries.size()/ENTRIES_PER_CELL));
+	cellsX = std::min(MAX_CELLS_PER_AXIS,std::max(1u,static_cast<uint32_t>(std::sqrt(numCells*width/height))));
+	cellsY = std::min(MAX_CELLS_PER_AXIS,std::max(1u,static_cast<uint32_t>(numCells/cellsX)));
+	cellWidth = width/cellsX;
+	cellHeight = height/cellsY;
+
+	// count the entries per cell and store the entries of each cell consecutively (in traversal order)
+	cellBegin.assign(cellsX*cellsY+1,0);
+	for(const auto & entry : entries){
+		for(uint32_t y = getCellY(entry.minY), yEnd = getCellY(entry.maxY); y<=yEnd; ++y){
+			for(uint32_t x = getCellX(entry.minX), xEnd = getCellX(entry.maxX); x<=xEnd; ++x)
+				++cellBegin[y*cellsX+x+1];
+		}
+	}
+	for(size_t i = 1; i<cellBegin.size(); ++i)
+		cellBegin[i] += cellBegin[i-1];
+	cellEntries.resize(cellBegin.back());
+	std::vector<uint32_t> cellEnd(cellBegin.begin(),cellBegin.end()-1);
+	for(uint32_t i = 0; i<entries.size(); ++i){
+		const Entry & entry = entries[i];
+		for(uint32_t y = getCellY(entry.minY), yEnd = getCellY(entry.maxY); y<=yEnd; ++y){
+			for(uint32_t x = getCellX(entry.minX), xEnd = getCellX(entry.maxX); x<=xEnd; ++x)
+				cellEntries[cellEnd[y*cellsX+x]++] = i;
+		}
+	}
+}
+
+/*! (internal) Add the component and its subtree. The component is marked as indexed, even if it can not be hit,
+	so that enabling or moving it invalidates the index. The subtree of a disabled component or of a component
+	lying outside of its clipping rect can not be hit and is skipped (as by Component::getComponentAtPos(...)).	*/
+void HitTestIndex::collect(Component & c, float clipMinX, float clipMinY, float clipMaxX, float clipMaxY){
+	c.setFlag(Component::HIT_TEST_INDEX_VALID,true);
+	if(!c.isEnabled())
+		return;
+	const Geometry::Rect rect = c.getHitTestRect() + c.getAbsPosition();
+	Entry entry;
+	entry.component = &c;
+	entry.minX = std::max(clipMinX,rect.getMinX());
+	entry.minY = std::max(clipMinY,rect.getMinY());
+	entry.maxX = std::min(clipMaxX,rect.getMaxX());
+	entry.maxY = std::min(clipMaxY,rect.getMaxY());
+	if(entry.minX>entry.maxX || entry.minY>entry.maxY) // the children are clipped by the empty rect as well
+		return;
+	entries.push_back(entry);
+
+	struct ChildVisitor : public Component::Visitor {
+		HitTestIndex & index;
+		const Entry & clip;
+		ChildVisitor(HitTestIndex & _index,const Entry & _clip) : Visitor(), index(_index), clip(_clip) {}
+		virtual ~ChildVisitor() {}
+
+		// ---|> Component::Visitor
+		Component::visitorResult_t visit(Component & child) override {
+			index.collect(child,clip.minX,clip.minY,clip.maxX,clip.maxY);
+			return Component::CONTINUE_TRAVERSAL;
+		}
+	}visitor(*this,entry);
+	c.traverseChildren(visitor);
+}
+
+//! (internal)
+uint32_t HitTestIndex::getCellX(float x)const{
+	return std::min(cellsX-1,static_cast<uint32_t>(std::max(0.0f,(x-minX)/cellWidth)));
+}
+
+//! (internal)
+uint32_t HitTestIndex::getCellY(float y)const{
+	return std::min(cellsY-1,static_cast<uint32_t>(std::max(0.0f,(y-minY)/cellHeight)));
+}
+
+//! (internal) The same conditions as used by Component::getComponentAtPos(...).
+bool HitTestIndex::isHit(Component * c, const Geometry::Vec2 & pos)const{
+	if(c->getFlag(Component::TRANSPARENT_COMPONENT))
+		return false;
+	for(Component * current = c; current!=nullptr; current = current->getParent()){
+		if(!current->isEnabled() || !current->coversAbsPosition(pos))
+			return false;
+		if(current==root)
+			return true;
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_HIT_TEST_INDEX_H
+#define GUI_HIT_TEST_INDEX_H
+
+#include <Geometry/Vec2.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GUI {
+
+class Component;
+
+/***
+ **	HitTestIndex
+ **	Uniform grid over the absolute hit test rects of all components of a subtree (e.g. a window).
+ **	The hit test rect of a component is clipped by the rects of its ancestors, as a component
+ **	can only be hit if all its ancestors cover the position.
+ **	The index is valid as long as the root has the Component::HIT_TEST_INDEX_VALID flag;
+ **	the flag is cleared by Component::invalidateLayout() and Component::invalidateAbsPosition().
+ **	As the hit test, the index skips disabled subtrees and the subtrees of components lying outside
+ **	of their parents (enabling or moving such a component invalidates the index).
+ **/
+class HitTestIndex{
+	public:
+		//! Maximal number of hit tests done without the index between two rebuilds of a repeatedly invalidated index.
+		static const uint32_t MAX_REBUILD_DELAY = 64;
+
+		explicit HitTestIndex(Component * _root) :
+				root(_root), cellsX(0), cellsY(0), minX(0), minY(0), maxX(0), maxY(0), cellWidth(1), cellHeight(1),
+				rebuiltForLastQuery(false), rebuildDelay(0), queriesUntilRebuild(0) {}
+
+		/*! Returns the same component as root->getComponentAtPos(pos), but only tests the components
+			whose clipped hit test rect overlaps the grid cell containing @p pos.
+			The index is rebuilt if it is no longer valid. If it has been invalidated again before it could
+			be reused (e.g. while a component is dragged), the following hit tests traverse the subtree
+			instead; the number of these hit tests doubles (up to MAX_REBUILD_DELAY) with every rebuild
+			that is invalidated before being reused.	*/
+		Component * getComponentAtPos(const Geometry::Vec2 & pos);
+
+		void rebuild();
+		bool isValid()const;
+		size_t getNumberOfEntries()const			{	return entries.size();	}
+
+	private:
+		struct Entry{
+			Component * component;
+			float minX, minY, maxX, maxY;
+		};
+		Component * root;
+		std::vector<Entry> entries;			//!< in traversal order (later entries are in front)
+		std::vector<uint32_t> cellBegin;	//!< cell i contains the entries cellEntries[cellBegin[i]] ... cellEntries[cellBegin[i+1]-1]
+		std::vector<uint32_t> cellEntries;
+		uint32_t cellsX, cellsY;
+		float minX, minY, maxX, maxY;		//!< bounds of all entries
+		float cellWidth, cellHeight;
+		bool rebuiltForLastQuery;			//!< the index has been rebuilt for the last hit test
+		uint32_t rebuildDelay;
+		uint32_t queriesUntilRebuild;		//!< number of hit tests still done without the index
+
+		void collect(Component & c, float clipMinX, float clipMinY, float clipMaxX, float clipMaxY);
+		uint32_t getCellX(float x)const;
+		uint32_t getCellY(float y)const;
+		bool isHit(Component * c, const Geometry::Vec2 & pos)const;
+};
+
+}
+
+#endif // GUI_HIT_TEST_INDEX_H
@@ -11,21 +11,47 @@
 #include "ImageData.h"
 
 #include "Draw.h"
+#include <Util/Graphics/Bitmap.h>
 #include <Util/Graphics/PixelAccessor.h>
+#include <Util/Graphics/PixelFormat.h>
+#include <algorithm>
 #include <iostream>
 
 namespace GUI{
 
+//! (internal)
+struct ImageData::ExternalData{
+	uint32_t width;
+	uint32_t height;
+	Util::PixelFormat format;
+	const uint8_t * pixels;
+	std::shared_ptr<const void> owner;
+
+	ExternalData(uint32_t _width, uint32_t _height, const Util::PixelFormat & _format, const uint8_t * _pixels, std::shared_ptr<const void> _owner) :
+			width(_width), height(_height), format(_format), pixels(_pixels), owner(std::move(_owner)) {}
+};
+
 //! (ctor)
 ImageData::ImageData(Util::Reference<Util::Bitmap> _bitmap):
 		ReferenceCounter_t(),
 		bitmap(std::move(_bitmap)),
 		textureId(0),
-		dataHasChanged(false) {
+		dataHasChanged(false),
+		alphaMask(false) {
 	dataChanged();
 }
 
 
+//! (ctor)
+ImageData::ImageData(uint32_t width, uint32_t height, const Util::PixelFormat & format, const uint8_t * pixels, std::shared_ptr<const void> dataOwner):
+		ReferenceCounter_t(),
+		externalData(new ExternalData(width,height,format,pixels,std::move(dataOwner))),
+		textureId(0),
+		dataHasChanged(false),
+		alphaMask(false) {
+	dataChanged();
+}
+
 //! (dtor)
 ImageData::~ImageData() {
 	removeGLData();
@@ -38,28 +64,60 @@ bool ImageData::uploadGLTexture() {
 	if( textureId==0 )
 		return false;
 
-	Draw::uploadTexture(textureId,bitmap->getWidth(),bitmap->getHeight(),bitmap->getPixelFormat(),getLocalData());
+	const uint8_t * pixels = externalData ? externalData->pixels : getLocalData(); // external data is uploaded directly
+	if(alphaMask && getPixelFormat()==Util::PixelFormat::MONO)
+		Draw::uploadAlphaTexture(textureId,getWidth(),getHeight(),pixels);
+	else
+		Draw::uploadTexture(textureId,getWidth(),getHeight(),getPixelFormat(),pixels);
 
 	dataHasChanged=false;
 	return true; 
 }
 
 uint8_t * ImageData::getLocalData() {
-	return bitmap->data();
+	return getBitmap()->data();
 }
 
 const uint8_t * ImageData::getLocalData() const {
-	return bitmap->data();
+	return getBitmap()->data();
+}
+
+const Util::Reference<Util::Bitmap> & ImageData::getBitmap() const {
+	if(externalData){ // create a local copy; the external data is released afterwards
+		bitmap = new Util::Bitmap(externalData->width,externalData->height,externalData->format);
+		std::copy(externalData->pixels, externalData->pixels + std::min<size_t>(bitmap->getDataSize(), 
+						static_cast<size_t>(externalData->width)*externalData->height*externalData->format.getBytesPerPixel()), bitmap->data());
+		externalData.reset();
+	}
+	return bitmap;
+}
+
+uint32_t ImageData::getWidth() const {
+	return externalData ? externalData->width : bitmap->getWidth();
+}
+
+uint32_t ImageData::getHeight() const {
+	return externalData ? externalData->height : bitmap->getHeight();
+}
+
+const Util::PixelFormat & ImageData::getPixelFormat() const {
+	return externalData ? externalData->format : bitmap->getPixelFormat();
 }
 
 bool ImageData::enable() {
-	if( (textureId == 0 || dataHasChanged) && !uploadGLTexture() )
+	if( prepareGLTexture()==0 )
 		return false;
 
 	Draw::enableTexture(textureId);
 	return true;
 }
 
+uint32_t ImageData::prepareGLTexture() {
+	if( (textureId == 0 || dataHasChanged) && !uploadGLTexture() )
+		return 0;
+	return textureId;
+}
+
 void ImageData::disable() {
 	if (textureId!=0) 
 		Draw::disableTexture();
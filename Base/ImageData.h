@@ -14,10 +14,12 @@
 #include <Util/ReferenceCounter.h>
 #include <Util/References.h>
 #include <cstdint>
+#include <memory>
 
 namespace Util{
 class Bitmap;
 class PixelAccessor;
+class PixelFormat;
 }
 namespace GUI {
 
@@ -41,6 +43,10 @@ class ImageData: public Util::ReferenceCounter<ImageData> {
 	public:
 
 		ImageData(Util::Reference<Util::Bitmap> _bitmap);
+		/*! Use external read-only pixel data (e.g. the pages of a memory mapped file) that is uploaded directly.
+			A local copy of the data is only created if the bitmap or the local data is accessed.
+			@param dataOwner is kept alive as long as @p pixels is used.	*/
+		ImageData(uint32_t width, uint32_t height, const Util::PixelFormat & format, const uint8_t * pixels, std::shared_ptr<const void> dataOwner);
 		~ImageData();
 
 	public:
@@ -49,14 +55,22 @@ class ImageData: public Util::ReferenceCounter<ImageData> {
 		uint8_t * getLocalData();
 		const uint8_t * getLocalData() const;
 
-		const Util::Reference<Util::Bitmap> & getBitmap() const {
-			return bitmap;
-		}
+		const Util::Reference<Util::Bitmap> & getBitmap() const;
+		uint32_t getWidth() const;
+		uint32_t getHeight() const;
+		const Util::PixelFormat & getPixelFormat() const;
+
+		/*! If enabled, single channel data is used as coverage: it is uploaded as alpha-only texture
+			(sampled as (1,1,1,value)) instead of as red channel.	*/
+		void setAlphaMask(bool b)					{	alphaMask = b;	dataChanged();	}
+		bool isAlphaMask() const					{	return alphaMask;	}
 
 		void updateData(const Util::Bitmap & bitmap);
 
 		bool enable();
 		void disable();
+		//! Upload the data if necessary and return the texture id (0 on failure) without enabling the texture.
+		uint32_t prepareGLTexture();
 		void dataChanged();
 
 		void removeGLData();
@@ -64,9 +78,12 @@ class ImageData: public Util::ReferenceCounter<ImageData> {
 		Util::Reference<Util::PixelAccessor> createPixelAccessor();
 
 	private:
-		Util::Reference<Util::Bitmap> bitmap;
+		mutable Util::Reference<Util::Bitmap> bitmap; // created on demand when external data is used
+		struct ExternalData;
+		mutable std::unique_ptr<ExternalData> externalData;
 		uint32_t textureId;
 		bool dataHasChanged;
+		bool alphaMask;
 };
 }
 #endif // GUI_IMAGE_DATA_H
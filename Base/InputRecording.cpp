@@ -0,0 +1,152 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "InputRecording.h"
+#include "../GUI_Manager.h"
+#include <Util/IO/FileName.h>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace GUI {
+
+/*	File layout (byte order of the writing machine):
+	InputRecordingHeader
+	records: uint8_t type, double time, followed by
+		RECORD_FRAME: uint32_t screenWidth, uint32_t screenHeight
+		RECORD_EVENT: Util::UI::Event (eventSize bytes)	*/
+struct InputRecordingHeader{
+	char magic[8];				// "GUIINPUT"
+	uint32_t version;
+	uint32_t byteOrderMark;		// 0x01020304
+	uint32_t eventSize;			// sizeof(Util::UI::Event)
+};
+static const char inputRecordingMagic[8] = {'G','U','I','I','N','P','U','T'};
+static const uint32_t inputRecordingVersion = 1;
+static const uint32_t inputRecordingByteOrderMark = 0x01020304;
+static const uint8_t RECORD_FRAME = 0;
+static const uint8_t RECORD_EVENT = 1;
+
+template<typename T>
+static void writeValue(std::ostream & out,const T & value){
+	out.write(reinterpret_cast<const char*>(&value),sizeof(T));
+}
+
+template<typename T>
+static bool readValue(std::istream & in,T & value){
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&value),sizeof(T)));
+}
+
+//! (ctor)
+InputRecorder::InputRecorder(const Util::FileName & fileName) :
+		out(fileName.getPath(),std::ios::binary|std::ios::trunc), numEvents(0), numFrames(0) {
+	if(!out)
+		throw std::runtime_error("InputRecorder: Could not open file '"+fileName.toString()+"'.");
+	InputRecordingHeader header;
+	std::memcpy(header.magic,inputRecordingMagic,sizeof(inputRecordingMagic));
+	header.version = inputRecordingVersion;
+	header.byteOrderMark = inputRecordingByteOrderMark;
+	header.eventSize = sizeof(Util::UI::Event);
+	writeValue(out,header);
+}
+
+//! (dtor)
+InputRecorder::~InputRecorder() {
+	out.flush();
+}
+
+void InputRecorder::recordEvent(double time,const Util::UI::Event & e){
+	writeValue(out,RECORD_EVENT);
+	writeValue(out,time);
+	writeValue(out,e);
+	++numEvents;
+}
+
+void InputRecorder::recordFrame(double time,uint32_t screenWidth,uint32_t screenHeight){
+	writeValue(out,RECORD_FRAME);
+	writeValue(out,time);
+	writeValue(out,screenWidth);
+	writeValue(out,screenHeight);
+	++numFrames;
+}
+
+// ------------------------------------------------------------------------
+
+//! (ctor)
+InputReplayer::InputReplayer(const Util::FileName & fileName) : numEvents(0) {
+	std::ifstream in(fileName.getPath(),std::ios::binary);
+	if(!in)
+		throw std::runtime_error("InputReplayer: Could not open file '"+fileName.toString()+"'.");
+	InputRecordingHeader header;
+	if(!readValue(in,header) || std::memcmp(header.magic,inputRecordingMagic,sizeof(inputRecordingMagic))!=0)
+		throw std::runtime_error("InputReplayer: Invalid recording '"+fileName.toString()+"'.");
+	if(header.version!=inputRecordingVersion || header.byteOrderMark!=inputRecordingByteOrderMark || header.eventSize!=sizeof(Util::UI::Event))
+		throw std::runtime_error("InputReplayer: Unsupported version, byte order or event layout of recording '"+fileName.toString()+"'.");
+
+	uint8_t type;
+	while(readValue(in,type)){
+		Record record;
+		std::memset(&record,0,sizeof(Record));
+		bool valid = readValue(in,record.time);
+		if(type==RECORD_FRAME){
+			record.isFrame = true;
+			valid = valid && readValue(in,record.screenWidth) && readValue(in,record.screenHeight);
+		}else if(type==RECORD_EVENT){
+			record.isFrame = false;
+			valid = valid && readValue(in,record.event);
+			++numEvents;
+		}else{
+			valid = false;
+		}
+		if(!valid)
+			throw std::runtime_error("InputReplayer: Corrupt recording '"+fileName.toString()+"'.");
+		records.push_back(record);
+	}
+}
+
+std::vector<InputReplayer::FrameTimings> InputReplayer::replay(GUI_Manager & gui)const{
+	typedef std::chrono::steady_clock clock_t;
+	const auto secondsSince = [](const clock_t::time_point & start){
+		return std::chrono::duration<double>(clock_t::now()-start).count();
+	};
+
+	// restores the gui's clock, even if a listener throws
+	struct ClockGuard{
+		GUI_Manager & gui;
+		GUI_Manager::timeSource_t previousTimeSource;
+		~ClockGuard()	{	gui.setTimeSource(std::move(previousTimeSource));	}
+	}clockGuard{gui,gui.getTimeSource()};
+	double currentTime = 0.0;
+	gui.setTimeSource([&currentTime](){	return currentTime;	});
+
+	std::vector<FrameTimings> timings;
+	FrameTimings frame = FrameTimings();
+	for(const auto & record : records){
+		currentTime = record.time;
+		if(!record.isFrame){
+			const auto start = clock_t::now();
+			gui.handleEvent(record.event);
+			frame.eventSeconds += secondsSince(start);
+			++frame.numEvents;
+			continue;
+		}
+		if(gui.isHeadless())
+			gui.setScreenSize(record.screenWidth,record.screenHeight);
+		frame.time = record.time;
+		gui.display();
+		frame.display = gui.getLastDisplayTimings();
+		timings.push_back(frame);
+		frame = FrameTimings();
+	}
+	return timings;
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_INPUT_RECORDING_H
+#define GUI_INPUT_RECORDING_H
+
+#include "../GUI_Manager.h"
+#include <Util/UI/Event.h>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace Util {
+class FileName;
+}
+namespace GUI {
+
+/***
+ **	InputRecorder
+ **	Writes the events and frames of a GUI_Manager (see GUI_Manager::setInputRecorder(...)) into a binary file
+ **	that can be replayed by an InputReplayer. Each record contains the GUI_Manager's time; frames additionally
+ **	contain the screen size.
+ **	\note The events are stored as they are in memory, so a recording can only be replayed by a build
+ **		using the same Util::UI::Event layout and byte order.
+ **/
+class InputRecorder{
+	public:
+		//! Create the file; throws an exception on failure.
+		explicit InputRecorder(const Util::FileName & file);
+		~InputRecorder();
+
+		void recordEvent(double time,const Util::UI::Event & e);
+		void recordFrame(double time,uint32_t screenWidth,uint32_t screenHeight);
+		void flush()							{	out.flush();	}
+
+		size_t getNumberOfEvents()const			{	return numEvents;	}
+		size_t getNumberOfFrames()const			{	return numFrames;	}
+
+	private:
+		std::ofstream out;
+		size_t numEvents;
+		size_t numFrames;
+};
+
+/***
+ **	InputReplayer
+ **	Feeds a recording of an InputRecorder into a GUI_Manager using the recorded time stamps as clock,
+ **	and measures the time needed for the events and for the phases of the display of each recorded frame.
+ **	Together with GUI_Manager::setHeadless(true), recordings can be replayed without a display.
+ **/
+class InputReplayer{
+	public:
+		struct FrameTimings{
+			double time;			//!< recorded time of the frame
+			size_t numEvents;		//!< number of events handled since the previous frame
+			double eventSeconds;	//!< time needed for handling these events
+			GUI_Manager::DisplayTimings display;	//!< phases of GUI_Manager::display() (see GUI_Manager::getLastDisplayTimings())
+		};
+
+		//! Load a recording; throws an exception if the file can not be read or is no valid recording.
+		explicit InputReplayer(const Util::FileName & file);
+
+		/*! Replay the recording: Before each record, the clock of the @p gui is set to the record's time.
+			Events are passed to GUI_Manager::handleEvent(...); for each frame, the screen size is set (in headless mode)
+			and the gui is displayed. The gui's original clock is restored afterwards.
+			Returns the timings of all frames.	*/
+		std::vector<FrameTimings> replay(GUI_Manager & gui)const;
+
+		size_t getNumberOfEvents()const			{	return numEvents;	}
+		size_t getNumberOfFrames()const			{	return records.size()-numEvents;	}
+
+	private:
+		struct Record{
+			double time;
+			bool isFrame;
+			uint32_t screenWidth;
+			uint32_t screenHeight;
+			Util::UI::Event event;
+		};
+		std::vector<Record> records;
+		size_t numEvents;
+};
+
+}
+
+#endif // GUI_INPUT_RECORDING_H
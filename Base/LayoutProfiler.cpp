@@ -0,0 +1,325 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "LayoutProfiler.h"
+#include "../Components/Component.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace GUI {
+
+static const size_t NO_RECORD = SIZE_MAX;
+
+static double secondsBetween(const std::chrono::steady_clock::time_point & start,const std::chrono::steady_clock::time_point & end){
+	return std::chrono::duration<double>(end-start).count();
+}
+
+static std::ostream & writeComponent(std::ostream & out,const Component * c,const char * typeName){
+	if(c==nullptr)
+		return out << "(outside of the layout)";
+	return out << typeName << "#" << static_cast<const void*>(c);
+}
+
+static std::ostream & writeInvalidation(std::ostream & out,const LayoutProfiler::InvalidationRecord & record){
+	writeComponent(out,record.source,record.sourceTypeName);
+	if(record.stepTypeName!=nullptr)
+		out << " [" << record.stepTypeName << "]";
+	out << " invalidated ";
+	return writeComponent(out,record.target,record.targetTypeName);
+}
+
+//! (ctor)
+LayoutProfiler::LayoutProfiler() : maxNumberOfPasses(16), diagnosticsOutput(&std::cout), passRunning(false) {
+}
+
+void LayoutProfiler::setMaxNumberOfPasses(size_t n){
+	maxNumberOfPasses = std::max(static_cast<size_t>(1),n);
+	while(passes.size()>maxNumberOfPasses)
+		passes.pop_front();
+}
+
+void LayoutProfiler::_beginPass(double time){
+	if(passes.size()>=maxNumberOfPasses)
+		passes.pop_front();
+	passes.emplace_back();
+	Pass & pass = passes.back();
+	pass.time = time;
+	pass.seconds = 0.0;
+	pass.numDroppedRecords = 0;
+	pass.invalidations.swap(pendingInvalidations);
+	pendingInvalidations.clear();
+	frames.clear();
+	passRunning = true;
+	passStart = clock_t::now();
+}
+
+void LayoutProfiler::_endPass(){
+	if(!passRunning)
+		return;
+	passes.back().seconds = secondsBetween(passStart,clock_t::now());
+	frames.clear();
+	passRunning = false;
+}
+
+void LayoutProfiler::_beginLayout(const Component & c){
+	if(!passRunning)
+		return;
+	Pass & pass = passes.back();
+	Frame frame;
+	frame.layoutIndex = NO_RECORD;
+	if(pass.layouts.size()<MAX_RECORDS_PER_PASS){
+		frame.layoutIndex = pass.layouts.size();
+		LayoutRecord record;
+		record.component = &c;
+		record.typeName = c.getTypeName();
+		record.depth = static_cast<uint32_t>(frames.size());
+		record.iterations = 0;
+		record.converged = true;
+		record.seconds = record.ownSeconds = 0.0;
+		pass.layouts.push_back(record);
+	}else{
+		++pass.numDroppedRecords;
+	}
+	frame.iterationBegin = pass.invalidations.size();
+	frame.iterations = 0;
+	frame.ownSeconds = 0.0;
+	frame.step = nullptr;
+	frame.start = clock_t::now();
+	frames.push_back(frame);
+}
+
+void LayoutProfiler::_beginIteration(){
+	if(frames.empty())
+		return;
+	frames.back().iterationBegin = passes.back().invalidations.size();
+	++frames.back().iterations;
+}
+
+void LayoutProfiler::_beginStep(const char * typeName){
+	if(frames.empty())
+		return;
+	frames.back().step = typeName;
+	frames.back().stepStart = clock_t::now();
+}
+
+void LayoutProfiler::_endStep(){
+	if(frames.empty() || frames.back().step==nullptr)
+		return;
+	Frame & frame = frames.back();
+	const double seconds = secondsBetween(frame.stepStart,clock_t::now());
+	frame.ownSeconds += seconds;
+	Pass & pass = passes.back();
+	if(frame.layoutIndex!=NO_RECORD && pass.steps.size()<MAX_RECORDS_PER_PASS){
+		StepRecord record;
+		record.layoutIndex = frame.layoutIndex;
+		record.typeName = frame.step;
+		record.seconds = seconds;
+		pass.steps.push_back(record);
+	}else{
+		++pass.numDroppedRecords;
+	}
+	frame.step = nullptr;
+}
+
+void LayoutProfiler::_layoutDidNotConverge(const Component & c){
+	if(frames.empty() || frames.back().layoutIndex==NO_RECORD)
+		return;
+	const Frame & frame = frames.back();
+	Pass & pass = passes.back();
+	LayoutRecord & layoutRecord = pass.layouts[frame.layoutIndex];
+	if(layoutRecord.component!=&c)
+		return;
+	layoutRecord.converged = false;
+	layoutRecord.iterations = frame.iterations;
+
+	NonConvergenceRecord record;
+	record.layoutIndex = frame.layoutIndex;
+	record.lastIteration.assign(pass.invalidations.begin()+frame.iterationBegin,pass.invalidations.end());
+	record.cycle = findCycle(record.lastIteration);
+	pass.nonConvergences.push_back(record);
+	if(diagnosticsOutput!=nullptr)
+		writeNonConvergence(*diagnosticsOutput,pass,pass.nonConvergences.back());
+}
+
+void LayoutProfiler::_endLayout(){
+	if(frames.empty())
+		return;
+	const Frame & frame = frames.back();
+	if(frame.layoutIndex!=NO_RECORD){
+		LayoutRecord & record = passes.back().layouts[frame.layoutIndex];
+		record.iterations = frame.iterations;
+		record.seconds = secondsBetween(frame.start,clock_t::now());
+		record.ownSeconds = frame.ownSeconds;
+	}
+	frames.pop_back();
+}
+
+void LayoutProfiler::_layoutInvalidated(const Component & c,bool wasValid){
+	if(!passRunning && !wasValid)
+		return;
+	std::vector<InvalidationRecord> & invalidations = passRunning ? passes.back().invalidations : pendingInvalidations;
+	if(invalidations.size()>=MAX_RECORDS_PER_PASS){
+		if(passRunning)
+			++passes.back().numDroppedRecords;
+		return;
+	}
+	InvalidationRecord record;
+	record.target = &c;
+	record.targetTypeName = c.getTypeName();
+	record.source = nullptr;
+	record.sourceTypeName = nullptr;
+	record.stepTypeName = nullptr;
+	if(!frames.empty()){
+		const Frame & frame = frames.back();
+		if(frame.layoutIndex!=NO_RECORD){
+			const LayoutRecord & source = passes.back().layouts[frame.layoutIndex];
+			record.source = source.component;
+			record.sourceTypeName = source.typeName;
+		}
+		record.stepTypeName = frame.step;
+	}
+	// Component::setRect(...) invalidates the same component several times; skip the recent duplicates of the current iteration.
+	const size_t iterationBegin = frames.empty() ? 0 : frames.back().iterationBegin;
+	for(size_t i = invalidations.size(), end = std::max(iterationBegin,invalidations.size()<8 ? 0 : invalidations.size()-8); i>end; ){
+		const InvalidationRecord & other = invalidations[--i];
+		if(other.target==record.target && other.source==record.source && other.stepTypeName==record.stepTypeName)
+			return;
+	}
+	invalidations.push_back(record);
+}
+
+/*! (static,internal) Search the graph (source -> target) of the given invalidations for a cycle by depth first search.
+	Components invalidating themselves are only reported if there is no longer cycle.	*/
+std::vector<LayoutProfiler::InvalidationRecord> LayoutProfiler::findCycle(const std::vector<InvalidationRecord> & invalidations){
+	std::unordered_map<const Component *,std::vector<size_t>> edges; // source -> indices of its invalidations
+	for(size_t i = 0; i<invalidations.size(); ++i){
+		const InvalidationRecord & record = invalidations[i];
+		if(record.source!=nullptr && record.source!=record.target)
+			edges[record.source].push_back(i);
+	}
+
+	enum state_t{	ON_PATH, FINISHED	};
+	std::unordered_map<const Component *,state_t> states;
+	std::vector<size_t> path; // indices of the invalidations leading to the current component
+
+	struct Search{
+		const std::vector<InvalidationRecord> & invalidations;
+		std::unordered_map<const Component *,std::vector<size_t>> & edges;
+		std::unordered_map<const Component *,state_t> & states;
+		std::vector<size_t> & path;
+
+		//! Returns the component closing the cycle or nullptr.
+		const Component * visit(const Component * c){
+			states[c] = ON_PATH;
+			for(const auto & i : edges[c]){
+				const Component * target = invalidations[i].target;
+				const auto it = states.find(target);
+				path.push_back(i);
+				if(it!=states.end() && it->second==ON_PATH)
+					return target;
+				if(it==states.end()){
+					const Component * cycleStart = visit(target);
+					if(cycleStart!=nullptr)
+						return cycleStart;
+				}
+				path.pop_back();
+			}
+			states[c] = FINISHED;
+			return nullptr;
+		}
+	}search{invalidations,edges,states,path};
+
+	std::vector<InvalidationRecord> cycle;
+	for(const auto & record : invalidations){
+		if(record.source==nullptr || states.count(record.source)>0)
+			continue;
+		const Component * cycleStart = search.visit(record.source);
+		if(cycleStart!=nullptr){
+			// skip the part of the path leading to the cycle
+			auto it = path.begin();
+			while(invalidations[*it].source!=cycleStart)
+				++it;
+			for(; it!=path.end(); ++it)
+				cycle.push_back(invalidations[*it]);
+			return cycle;
+		}
+	}
+	for(const auto & record : invalidations){
+		if(record.source!=nullptr && record.source==record.target){
+			cycle.push_back(record);
+			break;
+		}
+	}
+	return cycle;
+}
+
+void LayoutProfiler::writeNonConvergence(std::ostream & out,const Pass & pass,const NonConvergenceRecord & record)const{
+	const LayoutRecord & layout = pass.layouts[record.layoutIndex];
+	out << "LayoutProfiler: The layout of ";
+	writeComponent(out,layout.component,layout.typeName) << " did not converge after " << layout.iterations << " iteration(s).\n";
+	if(!record.cycle.empty()){
+		out << " Cycle:\n";
+		for(const auto & invalidation : record.cycle)
+			writeInvalidation(out << "  ",invalidation) << "\n";
+	}else{
+		out << " No cycle found; invalidations of the last iteration:\n";
+		for(const auto & invalidation : record.lastIteration)
+			writeInvalidation(out << "  ",invalidation) << "\n";
+	}
+}
+
+void LayoutProfiler::writeSummary(std::ostream & out,const Pass & pass,size_t maxComponents)const{
+	out << "Layout pass at " << pass.time << ": " << pass.seconds*1000.0 << " ms, " << pass.layouts.size() << " layouts, "
+			<< pass.steps.size() << " layouter calls, " << pass.invalidations.size() << " invalidations";
+	if(pass.numDroppedRecords>0)
+		out << " (" << pass.numDroppedRecords << " records dropped)";
+	out << "\n";
+
+	struct LayouterTotal{
+		size_t count = 0;
+		double seconds = 0.0;
+	};
+	std::map<std::string,LayouterTotal> totals;
+	for(const auto & step : pass.steps){
+		LayouterTotal & total = totals[step.typeName];
+		++total.count;
+		total.seconds += step.seconds;
+	}
+	std::vector<std::pair<std::string,LayouterTotal>> sortedTotals(totals.begin(),totals.end());
+	std::sort(sortedTotals.begin(),sortedTotals.end(),[](const std::pair<std::string,LayouterTotal> & a,const std::pair<std::string,LayouterTotal> & b){
+		return a.second.seconds>b.second.seconds;
+	});
+	out << " Layouters:\n";
+	for(const auto & entry : sortedTotals)
+		out << "  " << entry.first << ": " << entry.second.count << " calls, " << entry.second.seconds*1000.0 << " ms\n";
+
+	std::vector<const LayoutRecord *> slowest;
+	for(const auto & layout : pass.layouts)
+		slowest.push_back(&layout);
+	const size_t numSlowest = std::min(maxComponents,slowest.size());
+	std::partial_sort(slowest.begin(),slowest.begin()+numSlowest,slowest.end(),[](const LayoutRecord * a,const LayoutRecord * b){
+		return a->ownSeconds>b->ownSeconds;
+	});
+	out << " Slowest components (own time):\n";
+	for(size_t i = 0; i<numSlowest; ++i){
+		const LayoutRecord & layout = *slowest[i];
+		writeComponent(out << "  ",layout.component,layout.typeName) << ": " << layout.ownSeconds*1000.0 << " ms ("
+				<< layout.seconds*1000.0 << " ms with children, " << layout.iterations << " iterations)\n";
+	}
+
+	for(const auto & nonConvergence : pass.nonConvergences)
+		writeNonConvergence(out,pass,nonConvergence);
+}
+
+}
@@ -0,0 +1,144 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_LAYOUT_PROFILER_H
+#define GUI_LAYOUT_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <vector>
+
+namespace GUI {
+
+class Component;
+
+/***
+ **	LayoutProfiler
+ **	Records the layout passes of a GUI_Manager (see GUI_Manager::setLayoutProfiler(...)): which components are
+ **	layouted, how long their layouters (and doLayout()) take and which invalidations re-dirtied components.
+ **	During a pass, every invalidation of a component's layout is recorded (also if the component is already invalid,
+ **	as this may be the edge closing a cycle); between the passes, only invalidations clearing a valid LAYOUT_VALID flag.
+ **	If the layout of a component does not converge (see Component::MAX_LAYOUT_ITERATIONS), the invalidations of
+ **	its last iteration are searched for a cycle of components invalidating each other, which is written to the
+ **	diagnostics output.
+ **	\note Components are identified by their address and type name only; the records do not keep them alive,
+ **		so the address of a record may belong to an already destroyed component.
+ **	\note While a profiler is set, the top-level components are layouted sequentially (see GUI_Manager::setNumberOfLayoutThreads(...)).
+ **/
+class LayoutProfiler{
+	public:
+		//! A single call of Component::layout().
+		struct LayoutRecord{
+			const Component * component;
+			const char * typeName;
+			uint32_t depth;			//!< nesting level within the pass (0 for the global container)
+			uint32_t iterations;	//!< number of iterations of the children's and own layout
+			bool converged;
+			double seconds;			//!< including the children
+			double ownSeconds;		//!< the component's layouters and doLayout() only
+		};
+		//! A single execution of a layouter or of Component::doLayout() (typeName "doLayout").
+		struct StepRecord{
+			size_t layoutIndex;		//!< the LayoutRecord of the layouted component
+			const char * typeName;
+			double seconds;
+		};
+		/*! A component whose LAYOUT_VALID flag has been cleared, either by Component::invalidateLayout() or, for the
+			descendants of a resized component, by Component::invalidateSubtreeLayout().	*/
+		struct InvalidationRecord{
+			const Component * target;
+			const char * targetTypeName;
+			const Component * source;		//!< innermost component being layouted; nullptr outside of a layout pass
+			const char * sourceTypeName;
+			const char * stepTypeName;		//!< layouter (or "doLayout") being executed; nullptr if none
+		};
+		struct NonConvergenceRecord{
+			size_t layoutIndex;
+			std::vector<InvalidationRecord> cycle;		//!< empty if no cycle has been found
+			std::vector<InvalidationRecord> lastIteration;	//!< all invalidations of the last iteration
+		};
+		struct Pass{
+			double time;			//!< the GUI_Manager's time
+			double seconds;
+			std::vector<LayoutRecord> layouts;		//!< in the order the layouts have been started
+			std::vector<StepRecord> steps;
+			std::vector<InvalidationRecord> invalidations;	//!< including those since the previous pass (with source nullptr)
+			std::vector<NonConvergenceRecord> nonConvergences;
+			size_t numDroppedRecords;	//!< layouts, steps and invalidations exceeding MAX_RECORDS_PER_PASS
+		};
+
+		//! Maximal number of layout, step and invalidation records (each) of a single pass.
+		static const size_t MAX_RECORDS_PER_PASS = 100000;
+
+		LayoutProfiler();
+
+		//! The recorded passes; the most recent pass is the last one.
+		const std::deque<Pass> & getPasses()const		{	return passes;	}
+		void clear()									{	passes.clear();	}
+		//! Number of passes kept (default 16); older passes are discarded.
+		void setMaxNumberOfPasses(size_t n);
+		size_t getMaxNumberOfPasses()const				{	return maxNumberOfPasses;	}
+
+		/*! Stream to which the cycles of non converging layouts are written when they occur (default std::cout);
+			nullptr disables the output. The stream is not owned by the profiler.	*/
+		void setDiagnosticsOutput(std::ostream * out)	{	diagnosticsOutput = out;	}
+
+		//! Write the total time per layouter type, the @p maxComponents slowest components and the non converging layouts of a pass.
+		void writeSummary(std::ostream & out,const Pass & pass,size_t maxComponents=10)const;
+		//! Write a non converging layout and the cycle of invalidations (or all invalidations of the last iteration).
+		void writeNonConvergence(std::ostream & out,const Pass & pass,const NonConvergenceRecord & record)const;
+
+	/*!	@name Internal hooks
+		Called by GUI_Manager::updateLayout(), Component::layout(), Component::invalidateLayout() and Component::invalidateSubtreeLayout().	*/
+	//	@{
+		void _beginPass(double time);
+		void _endPass();
+		void _beginLayout(const Component & c);
+		void _beginIteration();
+		void _beginStep(const char * typeName);
+		void _endStep();
+		void _layoutDidNotConverge(const Component & c);
+		void _endLayout();
+		//! @p wasValid: the component's LAYOUT_VALID flag before the invalidation.
+		void _layoutInvalidated(const Component & c,bool wasValid);
+	//	@}
+
+	private:
+		typedef std::chrono::steady_clock clock_t;
+
+		//! A running Component::layout().
+		struct Frame{
+			size_t layoutIndex;			//!< SIZE_MAX if the record has been dropped
+			clock_t::time_point start;
+			size_t iterationBegin;		//!< index of the first invalidation of the current iteration
+			uint32_t iterations;
+			double ownSeconds;
+			const char * step;			//!< the running layouter or nullptr
+			clock_t::time_point stepStart;
+		};
+
+		std::deque<Pass> passes;
+		size_t maxNumberOfPasses;
+		std::ostream * diagnosticsOutput;
+
+		bool passRunning;
+		clock_t::time_point passStart;
+		std::vector<InvalidationRecord> pendingInvalidations; //!< since the previous pass
+		std::vector<Frame> frames;
+
+		static std::vector<InvalidationRecord> findCycle(const std::vector<InvalidationRecord> & invalidations);
+};
+
+}
+
+#endif // GUI_LAYOUT_PROFILER_H
@@ -11,6 +11,7 @@
 #ifndef GUI_ABSTRACT_LAYOUTER_H
 #define GUI_ABSTRACT_LAYOUTER_H
 
+#include "../ComponentAllocator.h"
 #include <Util/ReferenceCounter.h>
 #include <Util/TypeNameMacro.h>
 
@@ -21,11 +22,20 @@ class Component;
 //! AbstractLayouter
 class AbstractLayouter : public Util::ReferenceCounter<AbstractLayouter> {
 		PROVIDES_TYPE_NAME(AbstractLayouter)
+		PROVIDES_POOLED_ALLOCATION()
 
 	public:
 		virtual ~AbstractLayouter() {}
 
 		virtual void layout(Util::WeakPointer<Component> component) = 0;
+
+		//! What the result of a layouter depends on; determines when it is applied by Component::layout().
+		enum dependency_t{
+			DEPENDS_ON_PARENT,		//!< only on the parent (or other ancestors); applied before the children are layouted.
+			DEPENDS_ON_CHILDREN		//!< on the children; applied after the children are layouted.
+		};
+		// ---o
+		virtual dependency_t getDependency()const	{	return DEPENDS_ON_CHILDREN;	}
 		
 };
 
@@ -14,16 +14,10 @@
 
 namespace GUI{
 
+//! The children's extent is cached by the container, so nested auto-sized components are layouted in linear time.
 static Geometry::Vec2 getChildrensSize(Component * c){
-	Container * container = dynamic_cast<Container*>(c);
-	float x = 0.0f, y = 0.0f;
-	if(container){
-		for(Component * child=container->getFirstChild();child!=nullptr;child=child->getNext()){
-			x = std::max( x, child->getWidth()+child->getPosition().x() );
-			y = std::max( y, child->getHeight()+child->getPosition().y() );
-		}
-	}
-	return Geometry::Vec2(x,y);
+	Container * container = component_cast<Container>(c);
+	return container ? container->getChildrenExtent() : Geometry::Vec2(0,0);
 }
 
 //! ---|> AbstractLayouter
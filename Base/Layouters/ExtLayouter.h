@@ -97,6 +97,11 @@ class ExtLayouter : public AbstractLayouter{
 
 		//! ---|> AbstractLayouter
 		virtual void layout(Util::WeakPointer<Component> component) override;
+		//! ---|> AbstractLayouter
+		virtual dependency_t getDependency()const override{
+			return (flags & (WIDTH_CHILDREN_ABS|WIDTH_CHILDREN_REL|HEIGHT_CHILDREN_ABS|HEIGHT_CHILDREN_REL)) ?
+					DEPENDS_ON_CHILDREN : DEPENDS_ON_PARENT;
+		}
 	private:
 		Geometry::Vec2 extPos;
 		Geometry::Vec2 extSize;
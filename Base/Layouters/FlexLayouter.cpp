@@ -0,0 +1,183 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "FlexLayouter.h"
+#include "../../Components/Container.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace GUI {
+
+//! (static)
+FlexItem * FlexItem::get(const Component * c){
+	return c->getLayouter<FlexItem>();
+}
+
+// ------------------------------------------------------------------------------
+
+//! ---|> AbstractLayouter
+void FlexLayouter::layout(Util::WeakPointer<Component> component){
+	Container * container = component_cast<Container>(component.get());
+	if(!container){
+		throw std::invalid_argument("FlexLayouter can only be applied to Containers.");
+	}
+	const uint8_t mainAxis = direction==ROW ? 0 : 1;
+	const uint8_t crossAxis = 1-mainAxis;
+	const bool wrap = getWrap();
+	const bool autoSize = getAutoSize();
+
+	const Geometry::Rect innerRect = container->getInnerRect();
+	const Geometry::Vec2 innerSize(innerRect.getWidth(),innerRect.getHeight());
+	float availableMain = std::max(0.0f,innerSize[mainAxis]-2*margin);
+	float availableCross = std::max(0.0f,innerSize[crossAxis]-2*margin);
+
+	// an auto sized container breaks its lines independently of its own (previous) size
+	float breakMain = availableMain;
+	if(wrap && autoSize){
+		float maxMain = maxMainSize;
+		if(maxMain<=0 && container->hasParent()){
+			const Geometry::Rect parentRect = container->getParent()->getInnerRect();
+			const Geometry::Vec2 parentEnd(parentRect.getMaxX(),parentRect.getMaxY());
+			maxMain = parentEnd[mainAxis]-container->getPosition()[mainAxis];
+		}
+		const float border = (mainAxis==0 ? container->getWidth() : container->getHeight())-innerSize[mainAxis];
+		breakMain = maxMain>0 || container->hasParent() ? std::max(0.0f,maxMain-border-2*margin) : std::numeric_limits<float>::max();
+	}
+
+	// measure the children and break them into lines
+	previousChildSizes.swap(childSizes);
+	childSizes.clear();
+
+	entries.clear();
+	lines.clear();
+	Line line = {0, 0, 0.0f, 0.0f, 0.0f, 0.0f};
+	for(const auto & childRef : container->getChildren()){
+		Component * child = childRef.get();
+		if(!child->isEnabled())
+			continue;
+		Entry entry;
+		entry.component = child;
+		entry.item = FlexItem::get(child);
+		entry.sizes = nullptr;
+		Geometry::Vec2 size(child->getWidth(),child->getHeight());
+		if(entry.item!=nullptr){
+			const auto previous = previousChildSizes.find(child);
+			ChildSizes & sizes = childSizes[child];
+			sizes = previous!=previousChildSizes.end() ? previous->second : ChildSizes{size,Geometry::Vec2(-1,-1)};
+			if(Geometry::Vec2i(size)!=Geometry::Vec2i(sizes.assignedSize)) // the size has been changed from outside
+				sizes.ownSize = size;
+			size = sizes.ownSize;
+			if(entry.item->basis>=0)
+				size[mainAxis] = entry.item->basis;
+			entry.sizes = &sizes;
+		}
+		entry.mainSize = size[mainAxis];
+		entry.crossSize = size[crossAxis];
+
+		if(wrap && line.end>line.begin && line.mainSize+(line.end-line.begin)*gap+entry.mainSize>breakMain){
+			lines.push_back(line);
+			line = {entries.size(), entries.size(), 0.0f, 0.0f, 0.0f, 0.0f};
+		}
+		line.mainSize += entry.mainSize;
+		line.crossSize = std::max(line.crossSize,entry.crossSize);
+		if(entry.item!=nullptr){
+			line.growSum += entry.item->grow;
+			line.shrinkSum += entry.item->shrink*entry.mainSize;
+		}
+		entries.push_back(entry);
+		++line.end;
+	}
+	if(line.end>line.begin)
+		lines.push_back(line);
+	previousChildSizes.clear();
+
+	if(autoSize){
+		float contentMain = 0.0f, contentCross = 0.0f;
+		for(const auto & l : lines){
+			contentMain = std::max(contentMain,l.mainSize+(l.end-l.begin-1)*gap);
+			contentCross += l.crossSize;
+		}
+		if(!lines.empty())
+			contentCross += (lines.size()-1)*gap;
+		Geometry::Vec2 size(container->getWidth()-innerSize.x(),container->getHeight()-innerSize.y()); // border
+		size[mainAxis] += contentMain+2*margin;
+		size[crossAxis] += contentCross+2*margin;
+		container->setSize(size.x(),size.y());
+		availableMain = contentMain;
+		availableCross = contentCross;
+	}
+
+	// arrange the lines
+	const bool singleLine = !wrap && lines.size()==1;
+	float crossPos = innerRect.getPosition()[crossAxis]+margin;
+	for(const auto & l : lines){
+		const size_t count = l.end-l.begin;
+		const float lineCross = singleLine ? availableCross : l.crossSize;
+		float freeSpace = availableMain-l.mainSize-(count-1)*gap;
+
+		// grow or shrink the flexible entries
+		if(!autoSize && freeSpace>0 && l.growSum>0){
+			for(size_t i = l.begin; i<l.end; ++i){
+				if(entries[i].item!=nullptr)
+					entries[i].mainSize += freeSpace*entries[i].item->grow/l.growSum;
+			}
+			freeSpace = 0.0f;
+		}else if(!autoSize && freeSpace<0 && l.shrinkSum>0){
+			const float missingSpace = -freeSpace;
+			for(size_t i = l.begin; i<l.end; ++i){
+				Entry & entry = entries[i];
+				if(entry.item==nullptr)
+					continue;
+				const float newSize = std::max(0.0f,entry.mainSize-missingSpace*entry.item->shrink*entry.mainSize/l.shrinkSum);
+				freeSpace += entry.mainSize-newSize;
+				entry.mainSize = newSize;
+			}
+		}
+
+		float mainPos = innerRect.getPosition()[mainAxis]+margin;
+		float spacing = gap;
+		if(freeSpace>0){
+			if(justify==JUSTIFY_CENTER){
+				mainPos += freeSpace*0.5f;
+			}else if(justify==JUSTIFY_END){
+				mainPos += freeSpace;
+			}else if(justify==JUSTIFY_SPACE_BETWEEN && count>1){
+				spacing += freeSpace/(count-1);
+			}
+		}
+
+		for(size_t i = l.begin; i<l.end; ++i){
+			const Entry & entry = entries[i];
+			const align_t align = entry.item!=nullptr && entry.item->alignSelf!=FlexItem::ALIGN_AUTO ?
+					entry.item->alignSelf : alignItems;
+			Geometry::Vec2 pos, size;
+			pos[mainAxis] = mainPos;
+			pos[crossAxis] = crossPos;
+			size[mainAxis] = entry.mainSize;
+			size[crossAxis] = entry.crossSize;
+			if(align==FlexItem::ALIGN_STRETCH){
+				if(entry.item!=nullptr) // children without item keep their size
+					size[crossAxis] = lineCross;
+			}else if(align==FlexItem::ALIGN_CENTER){
+				pos[crossAxis] += (lineCross-entry.crossSize)*0.5f;
+			}else if(align==FlexItem::ALIGN_END){
+				pos[crossAxis] += lineCross-entry.crossSize;
+			}
+			if(entry.sizes!=nullptr)
+				entry.sizes->assignedSize = size;
+			entry.component->setRect(Geometry::Rect(pos.x(),pos.y(),size.x(),size.y()));
+			mainPos += entry.mainSize+spacing;
+		}
+		crossPos += lineCross+gap;
+	}
+}
+
+}
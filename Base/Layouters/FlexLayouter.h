@@ -0,0 +1,160 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_FLEX_LAYOUTER_H
+#define GUI_FLEX_LAYOUTER_H
+
+#include "AbstractLayouter.h"
+#include <Geometry/Vec2.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace GUI {
+
+/***
+ **	FlexItem ---|> AbstractLayouter
+ **	Properties of a child of a container layouted by a FlexLayouter. The item is added to the child as layouter;
+ **	its own layout(...) does nothing. Children without an item keep their size and are only positioned.
+ **	An item only holds the flex properties, so the same item can be shared by several children.
+ **/
+class FlexItem : public AbstractLayouter{
+		PROVIDES_TYPE_NAME(FlexItem)
+	public:
+		//! Alignment on the cross axis; ALIGN_AUTO uses the container's alignment.
+		enum align_t : uint8_t{	ALIGN_AUTO, ALIGN_START, ALIGN_CENTER, ALIGN_END, ALIGN_STRETCH	};
+
+		/*! @p grow and @p shrink are the weights for distributing free space or missing space on the main axis;
+			a negative @p basis uses the child's own size on the main axis as basis.	*/
+		explicit FlexItem(float _grow=0.0f, float _shrink=1.0f, float _basis=-1.0f, align_t _alignSelf=ALIGN_AUTO) :
+				AbstractLayouter(), grow(_grow), shrink(_shrink), basis(_basis), alignSelf(_alignSelf) {}
+		virtual ~FlexItem(){}
+
+		float getGrow()const				{	return grow;	}
+		float getShrink()const				{	return shrink;	}
+		float getBasis()const				{	return basis;	}
+		align_t getAlignSelf()const			{	return alignSelf;	}
+		void setGrow(float f)				{	grow = f;	}
+		void setShrink(float f)				{	shrink = f;	}
+		void setBasis(float f)				{	basis = f;	}
+		void setAlignSelf(align_t a)		{	alignSelf = a;	}
+
+		//! Returns the item of the given component or nullptr.
+		static FlexItem * get(const Component * c);
+
+		//! ---|> AbstractLayouter
+		virtual void layout(Util::WeakPointer<Component>) override	{	}
+		//! ---|> AbstractLayouter
+		virtual dependency_t getDependency()const override				{	return DEPENDS_ON_PARENT;	}
+
+	private:
+		friend class FlexLayouter;
+		float grow;
+		float shrink;
+		float basis;
+		align_t alignSelf;
+};
+
+/***
+ **	FlexLayouter ---|> AbstractLayouter
+ **	Places the enabled children of a container along a main axis (row or column) in one or more lines,
+ **	similar to the CSS flexible box layout. The children's sizes are measured in one pass and the
+ **	children are arranged in a second pass (both linear in the number of children).
+ **	\note In contrast to CSS, shrinking is only limited by zero and does not redistribute the space
+ **		of items that reached this limit.
+ **/
+class FlexLayouter : public AbstractLayouter{
+		PROVIDES_TYPE_NAME(FlexLayouter)
+	public:
+		enum direction_t : uint8_t{	ROW, COLUMN	};
+		//! Distribution of the remaining space on the main axis.
+		enum justify_t : uint8_t{	JUSTIFY_START, JUSTIFY_CENTER, JUSTIFY_END, JUSTIFY_SPACE_BETWEEN	};
+		typedef FlexItem::align_t align_t;
+
+		FlexLayouter() : AbstractLayouter(), gap(0.0f), margin(0.0f), maxMainSize(0.0f),
+				direction(ROW), justify(JUSTIFY_START), alignItems(FlexItem::ALIGN_START), flags(0) {}
+		FlexLayouter(const FlexLayouter & ) = default;
+		virtual ~FlexLayouter(){}
+
+		direction_t getDirection()const		{	return direction;	}
+		justify_t getJustify()const			{	return justify;	}
+		align_t getAlignItems()const		{	return alignItems;	}
+		//! Space between neighboring children and between lines.
+		float getGap()const					{	return gap;	}
+		//! Space between the container's inner rect and the children.
+		float getMargin()const				{	return margin;	}
+		bool getWrap()const					{	return flags&FLAG_WRAP;	}
+		bool getAutoSize()const				{	return flags&FLAG_AUTO_SIZE;	}
+		float getMaxMainSize()const			{	return maxMainSize;	}
+
+		void setDirection(direction_t d)	{	direction = d;	}
+		void setJustify(justify_t j)		{	justify = j;	}
+		//! ALIGN_AUTO is treated as ALIGN_START.
+		void setAlignItems(align_t a)		{	alignItems = a;	}
+		void setGap(float f)				{	gap = f;	}
+		void setMargin(float f)				{	margin = f;	}
+		//! If true, the children are broken into several lines if they do not fit into the container.
+		void setWrap(bool b)				{	b ? flags|=FLAG_WRAP : flags &= ~FLAG_WRAP;	}
+		/*! If true, the container's size is set to the size of its contents; the children are then neither
+			grown nor shrunk. If wrapping is enabled, the lines are broken at the maximal main size (see setMaxMainSize(...)),
+			as the container's own size is the result of the previous layout.	*/
+		void setAutoSize(bool b)			{	b ? flags|=FLAG_AUTO_SIZE : flags &= ~FLAG_AUTO_SIZE;	}
+		/*! Maximal main size of an auto sized, wrapping container (including its border).
+			If <= 0 (default), the space from the container's position to the end of its parent's inner rect is used;
+			a container without parent is not wrapped.	*/
+		void setMaxMainSize(float f)		{	maxMainSize = f;	}
+
+		//! ---|> AbstractLayouter
+		virtual void layout(Util::WeakPointer<Component> component) override;
+
+	private:
+		typedef uint8_t flag_t;
+		static const flag_t FLAG_WRAP = 1<<0;
+		static const flag_t FLAG_AUTO_SIZE = 1<<1;
+
+		float gap;
+		float margin;
+		float maxMainSize;
+		direction_t direction;
+		justify_t justify;
+		align_t alignItems;
+		flag_t flags;
+
+		/*! The own size (used as basis and cross size) of a child with a FlexItem and the size assigned by the last layout.
+			If the child still has the assigned size, the own size is used instead; otherwise, the child's
+			size has been changed from outside and becomes its new own size.	*/
+		struct ChildSizes{
+			Geometry::Vec2 ownSize;
+			Geometry::Vec2 assignedSize;
+		};
+		//! The sizes of the current children (the entries of removed children are dropped by the next layout).
+		std::unordered_map<const Component *,ChildSizes> childSizes, previousChildSizes;
+
+		//! Measured data of a child; reused between layouts to avoid allocations.
+		struct Entry{
+			Component * component;
+			FlexItem * item;
+			ChildSizes * sizes;		//!< nullptr if the child has no item
+			float mainSize;
+			float crossSize;
+		};
+		struct Line{
+			size_t begin, end;
+			float mainSize;		//!< sum of the entries' main sizes (without gaps)
+			float crossSize;	//!< maximal cross size of the entries
+			float growSum;
+			float shrinkSum;	//!< sum of the entries' shrink factors weighted by their main size
+		};
+		std::vector<Entry> entries;
+		std::vector<Line> lines;
+};
+
+}
+#endif // GUI_FLEX_LAYOUTER_H
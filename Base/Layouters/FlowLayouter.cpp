@@ -20,7 +20,7 @@ namespace GUI {
 
 //! ---|> AbstractLayouter
 void FlowLayouter::layout(Util::WeakPointer<Component> component){
-	Container * container = dynamic_cast<Container*>(component.get());
+	Container * container = component_cast<Container>(component.get());
 	if(!container){
 		throw std::invalid_argument("FlowLayouter can only be applied to Containers.");
 	}
@@ -32,13 +32,14 @@ void FlowLayouter::layout(Util::WeakPointer<Component> component){
 
 		unsigned int columnNr=0;
 		float currentWidth = 0;
-		for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+		for(const auto & cRef : container->getChildren()){
+			Component * c = cRef.get();
 			// next row
-			if(dynamic_cast<NextRow*>(c)){
+			if(component_cast<NextRow>(c)){
 				columnNr = 0;
 				currentWidth = 0;
 			} // next column
-			else if(NextColumn *nc=dynamic_cast<NextColumn*>(c)){
+			else if(NextColumn *nc=component_cast<NextColumn>(c)){
 				currentWidth += nc->additionalSpacing;
 
 				if( columnNr >= columnWidths.size() ){
@@ -76,14 +77,15 @@ void FlowLayouter::layout(Util::WeakPointer<Component> component){
 
 		float maxY=cursor.getY();
 		float maxX=0;
-		for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+		for(const auto & cRef : container->getChildren()){
+			Component * c = cRef.get();
 			// next row
-			if(NextRow *nr=dynamic_cast<NextRow*>(c)){
+			if(NextRow *nr=component_cast<NextRow>(c)){
 				columnNr=0;
 				cursor.setX(columnStarts.front());
 				cursor.setY(maxY+padding+nr->additionalSpacing);
 			} // next column
-			else if(dynamic_cast<NextColumn*>(c)){
+			else if(component_cast<NextColumn>(c)){
 				++columnNr;
 				cursor.setX(columnStarts[columnNr]);
 			} // other component
@@ -0,0 +1,239 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "GridLayouter.h"
+#include "../../Components/Container.h"
+#include "../../Components/ScrollableContainer.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace GUI {
+
+void GridLayouter::setColumnWidth(uint32_t column,float width){
+	if(column>=columnWidths.size())
+		columnWidths.resize(column+1,0.0f);
+	columnWidths[column] = std::max(width,0.0f);
+}
+
+//! ---|> AbstractLayouter
+void GridLayouter::layout(Util::WeakPointer<Component> component){
+	if(isVirtual()){
+		ScrollableContainer * scrollableContainer = component_cast<ScrollableContainer>(component.get());
+		if(!scrollableContainer){
+			throw std::invalid_argument("GridLayouter: Virtual cells can only be used with ScrollableContainers.");
+		}
+		layoutVirtualCells(*scrollableContainer);
+	}else{
+		Container * container = component_cast<Container>(component.get());
+		if(!container){
+			throw std::invalid_argument("GridLayouter can only be applied to Containers.");
+		}
+		layoutChildCells(*container);
+	}
+}
+
+//! (internal)
+void GridLayouter::layoutChildCells(Container & container){
+	// measure
+	std::vector<float> widths(numColumns,0.0f);
+	std::vector<float> heights;
+	size_t index = 0;
+	for(const auto & cell : container.getChildren()){
+		if(!cell->isEnabled())
+			continue;
+		const uint32_t column = index%numColumns;
+		const size_t row = index/numColumns;
+		if(row>=heights.size())
+			heights.push_back(rowHeight);
+		if(getColumnWidth(column)>0)
+			widths[column] = getColumnWidth(column);
+		else
+			widths[column] = std::max(widths[column],cell->getWidth());
+		if(rowHeight<=0)
+			heights[row] = std::max(heights[row],cell->getHeight());
+		++index;
+	}
+
+	columnOffsets.resize(numColumns+1);
+	float x = margin;
+	for(uint32_t column = 0; column<numColumns; ++column){
+		columnOffsets[column] = x;
+		x += widths[column]+gap;
+	}
+	columnOffsets[numColumns] = x-gap;
+
+	// arrange
+	index = 0;
+	float y = margin;
+	for(const auto & cell : container.getChildren()){
+		if(!cell->isEnabled())
+			continue;
+		const uint32_t column = index%numColumns;
+		const size_t row = index/numColumns;
+		if(column==0 && row>0)
+			y += heights[row-1]+gap;
+		cell->setRect(Geometry::Rect(columnOffsets[column],y,
+				getColumnWidth(column)>0 ? widths[column] : cell->getWidth(),
+				rowHeight>0 ? rowHeight : cell->getHeight()));
+		++index;
+	}
+	if(!heights.empty())
+		y += heights.back();
+	const Geometry::Vec2 size(columnOffsets[numColumns]+margin,y+margin);
+	container.setSize(size.x(),size.y());
+}
+
+// ------------------------------------------------------------------------------
+// virtual mode
+
+void GridLayouter::setVirtualCells(uint32_t _numRows,cellFactory_t factory,cellBinder_t binder){
+	resetVirtualCells();
+	numRows = _numRows;
+	cellFactory = std::move(factory);
+	cellBinder = std::move(binder);
+}
+
+//! (internal) Destroy all cells created by the layouter.
+void GridLayouter::resetVirtualCells(){
+	std::vector<Component::Ref> cells;
+	cells.swap(activeCells);
+	cells.insert(cells.end(),cellPool.begin(),cellPool.end());
+	cellPool.clear();
+	measuredColumnWidths.clear();
+	rowBegin = rowEnd = columnBegin = columnEnd = 0;
+	rebindCells = false;
+	cellContainer = nullptr;
+	if(!cells.empty())
+		Component::destroy(cells);
+}
+
+//! (internal)
+void GridLayouter::layoutVirtualCells(ScrollableContainer & scrollableContainer){
+	if(rowHeight<=0){
+		throw std::logic_error("GridLayouter: Virtual cells require a fixed row height.");
+	}
+	Container * content = scrollableContainer.getContentContainer();
+	bool cellsValid = content==cellContainer.get();
+	for(const auto & cell : activeCells) // removed from outside?
+		cellsValid = cellsValid && cell->getParent()==content;
+	if(!cellsValid){
+		resetVirtualCells();
+		cellContainer = content;
+	}
+	measuredColumnWidths.resize(numColumns,0.0f);
+	updateVirtualColumnOffsets();
+	const float rowPitch = rowHeight+gap;
+
+	// determine the visible range
+	const Geometry::Vec2 & scrollPos = scrollableContainer.getScrollPos();
+	const float top = scrollPos.y()-margin;
+	const float bottom = top+scrollableContainer.getHeight();
+	const uint32_t newRowBegin = top<=0 ? 0 : std::min(numRows,static_cast<uint32_t>(top/rowPitch));
+	const uint32_t newRowEnd = bottom<=0 ? 0 : std::min(numRows,static_cast<uint32_t>(std::ceil(bottom/rowPitch)));
+	const auto columnStartsEnd = columnOffsets.begin()+numColumns;
+	uint32_t newColumnBegin = std::upper_bound(columnOffsets.begin(),columnStartsEnd,scrollPos.x())-columnOffsets.begin();
+	if(newColumnBegin>0)
+		--newColumnBegin; // the column containing the left border
+	const uint32_t newColumnEnd = std::lower_bound(columnOffsets.begin(),columnStartsEnd,
+													scrollPos.x()+scrollableContainer.getWidth())-columnOffsets.begin();
+	const uint32_t newColumns = newColumnEnd>newColumnBegin ? newColumnEnd-newColumnBegin : 0;
+
+	// keep the cells that stay visible; the others are disabled and put into the pool
+	newActiveCells.resize(static_cast<size_t>(newRowEnd>newRowBegin ? newRowEnd-newRowBegin : 0)*newColumns);
+	const uint32_t oldColumns = columnEnd-columnBegin;
+	for(size_t i = 0; i<activeCells.size(); ++i){
+		const uint32_t row = rowBegin+i/oldColumns;
+		const uint32_t column = columnBegin+i%oldColumns;
+		if(!rebindCells && row>=newRowBegin && row<newRowEnd && column>=newColumnBegin && column<newColumnEnd){
+			newActiveCells[(row-newRowBegin)*newColumns+column-newColumnBegin] = std::move(activeCells[i]);
+		}else{
+			activeCells[i]->disable();
+			cellPool.push_back(std::move(activeCells[i]));
+		}
+	}
+	activeCells.clear();
+	activeCells.swap(newActiveCells);
+	rowBegin = newRowBegin;
+	rowEnd = newRowEnd;
+	columnBegin = newColumnBegin;
+	columnEnd = newColumnBegin+newColumns;
+	rebindCells = false;
+
+	// fill the newly visible cells, reusing pooled cells first
+	std::vector<Component::Ref> createdCells;
+	for(size_t i = 0; i<activeCells.size(); ++i){
+		Component::Ref & cell = activeCells[i];
+		if(cell.isNotNull())
+			continue;
+		if(!cellPool.empty()){
+			cell = std::move(cellPool.back());
+			cellPool.pop_back();
+			cell->enable();
+		}else{
+			cell = cellFactory(content->getGUI());
+			if(cell.isNull())
+				throw std::runtime_error("GridLayouter: The cell factory returned no component.");
+			createdCells.push_back(cell);
+		}
+		cellBinder(*cell.get(),rowBegin+i/newColumns,columnBegin+i%newColumns);
+	}
+	if(!createdCells.empty())
+		content->_addChildren(createdCells);
+
+	// the pool is limited by the number of visible cells
+	if(cellPool.size()>activeCells.size()){
+		const std::vector<Component::Ref> surplus(cellPool.begin()+activeCells.size(),cellPool.end());
+		cellPool.resize(activeCells.size());
+		Component::destroy(surplus);
+	}
+
+	// measure the materialized cells; a wider cell moves the following columns
+	bool widthsGrown = false;
+	for(size_t i = 0; i<activeCells.size(); ++i){
+		const uint32_t column = columnBegin+i%newColumns;
+		const float width = activeCells[i]->getWidth();
+		if(getColumnWidth(column)<=0 && width>measuredColumnWidths[column]){
+			measuredColumnWidths[column] = width;
+			widthsGrown = true;
+		}
+	}
+	// The columns can only move to the right, so the materialized range still covers the visible columns.
+	if(widthsGrown)
+		updateVirtualColumnOffsets();
+
+	// arrange the materialized cells
+	for(size_t i = 0; i<activeCells.size(); ++i){
+		Component * cell = activeCells[i].get();
+		const uint32_t row = rowBegin+i/newColumns;
+		const uint32_t column = columnBegin+i%newColumns;
+		const float width = getColumnWidth(column)>0 ? getColumnWidth(column) : cell->getWidth();
+		cell->setRect(Geometry::Rect(columnOffsets[column],margin+row*rowPitch,width,rowHeight));
+	}
+
+	// the content container has the size of the whole grid (with the measured widths known so far)
+	float width = 2*margin+(numColumns-1)*gap;
+	for(uint32_t column = 0; column<numColumns; ++column)
+		width += getColumnWidth(column)>0 ? getColumnWidth(column) : measuredColumnWidths[column];
+	const float height = 2*margin+(numRows>0 ? numRows*rowPitch-gap : 0.0f);
+	content->setSize(width,height);
+}
+
+//! (internal)
+void GridLayouter::updateVirtualColumnOffsets(){
+	columnOffsets.resize(numColumns+1);
+	float x = margin;
+	for(uint32_t column = 0; column<numColumns; ++column){
+		columnOffsets[column] = x;
+		x += (getColumnWidth(column)>0 ? getColumnWidth(column) : measuredColumnWidths[column])+gap;
+	}
+	columnOffsets[numColumns] = x-gap;
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_GRID_LAYOUTER_H
+#define GUI_GRID_LAYOUTER_H
+
+#include "AbstractLayouter.h"
+#include "../../Components/Component.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace GUI {
+
+class Container;
+class ScrollableContainer;
+
+/***
+ **	GridLayouter ---|> AbstractLayouter
+ **	Arranges cells in rows and columns. The width of a column is either fixed (cells are resized to it) or
+ **	measured as the maximal width of the column's cells; the same holds for the height of the rows.
+ **	- Normal mode: The enabled children of the layouted container are the cells in row-major order.
+ **		The container's size is set to the size of the grid.
+ **	- Virtual mode (see setVirtualCells(...)): The layouter is applied to a ScrollableContainer and creates
+ **		the cells itself as children of the content container. Only the cells intersecting the visible part
+ **		are materialized; cells scrolled out of view are disabled and reused for the cells scrolled into view.
+ **		The content container gets the size of the whole grid and must not have other layouters.
+ **/
+class GridLayouter : public AbstractLayouter{
+		PROVIDES_TYPE_NAME(GridLayouter)
+	public:
+		GridLayouter() : AbstractLayouter(), numColumns(1), rowHeight(0.0f), gap(0.0f), margin(0.0f),
+				numRows(0), rowBegin(0), rowEnd(0), columnBegin(0), columnEnd(0), rebindCells(false) {}
+		virtual ~GridLayouter(){}
+
+		uint32_t getNumberOfColumns()const					{	return numColumns;	}
+		void setNumberOfColumns(uint32_t n)					{	numColumns = std::max(n,static_cast<uint32_t>(1));	}
+		//! Returns the fixed width of the column or 0 if the width is measured.
+		float getColumnWidth(uint32_t column)const			{	return column<columnWidths.size() ? columnWidths[column] : 0.0f;	}
+		//! A width <= 0 means that the width is measured.
+		void setColumnWidth(uint32_t column,float width);
+		//! Returns the fixed height of all rows or 0 if the heights are measured.
+		float getRowHeight()const							{	return rowHeight;	}
+		//! A height <= 0 means that the height of each row is measured (not supported in virtual mode).
+		void setRowHeight(float h)							{	rowHeight = std::max(h,0.0f);	}
+		//! Space between neighboring rows and columns.
+		float getGap()const									{	return gap;	}
+		void setGap(float f)								{	gap = f;	}
+		//! Space around the grid.
+		float getMargin()const								{	return margin;	}
+		void setMargin(float f)								{	margin = f;	}
+
+		//! ---|> AbstractLayouter
+		virtual void layout(Util::WeakPointer<Component> component) override;
+
+	private:
+		uint32_t numColumns;
+		std::vector<float> columnWidths;
+		float rowHeight;
+		float gap;
+		float margin;
+		//! Start of each column and the end of the grid (numColumns+1 values); reused between layouts.
+		std::vector<float> columnOffsets;
+
+		void layoutChildCells(Container & container);
+		void layoutVirtualCells(ScrollableContainer & scrollableContainer);
+
+	/*! @name Virtual mode
+		The cells are provided by a factory and filled with the data of a (row,column) by a binder. The layout of the
+		layouted ScrollableContainer is invalidated whenever it is scrolled; after the data has been changed, call
+		refreshCells() or setNumberOfRows(...) and invalidate the layout.
+		The widths of measured columns are the maximal widths of all cells materialized so far.	*/
+	// @{
+	public:
+		typedef std::function<Component * (GUI_Manager &)> cellFactory_t;
+		typedef std::function<void (Component & cell,uint32_t row,uint32_t column)> cellBinder_t;
+
+		void setVirtualCells(uint32_t numRows,cellFactory_t factory,cellBinder_t binder);
+		bool isVirtual()const								{	return static_cast<bool>(cellBinder);	}
+
+		uint32_t getNumberOfRows()const						{	return numRows;	}
+		void setNumberOfRows(uint32_t n)					{	numRows = n;	rebindCells = true;	}
+		//! Bind all materialized cells again during the next layout.
+		void refreshCells()									{	rebindCells = true;	}
+
+		size_t getNumberOfMaterializedCells()const			{	return activeCells.size();	}
+		size_t getNumberOfPooledCells()const				{	return cellPool.size();	}
+
+	private:
+		cellFactory_t cellFactory;
+		cellBinder_t cellBinder;
+		uint32_t numRows;
+		uint32_t rowBegin, rowEnd, columnBegin, columnEnd;	//!< materialized range
+		bool rebindCells;
+		Util::WeakPointer<Container> cellContainer;
+		std::vector<Component::Ref> activeCells;			//!< cells of the materialized range in row-major order
+		std::vector<Component::Ref> newActiveCells;			//!< reused while updating the range
+		std::vector<Component::Ref> cellPool;				//!< disabled children of the cellContainer
+		std::vector<float> measuredColumnWidths;			//!< widest materialized cell per column so far
+
+		void resetVirtualCells();
+		//! Set the columnOffsets from the fixed and the measured column widths.
+		void updateVirtualColumnOffsets();
+	// @}
+};
+
+}
+#endif // GUI_GRID_LAYOUTER_H
@@ -0,0 +1,109 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_LISTENER_REGISTRY_H
+#define GUI_LISTENER_REGISTRY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GUI {
+
+/***
+ **	ListenerRegistry
+ **	Registry for listener functions with the interface of Util::Registry (registerElement/unregisterElement),
+ **	whose elements can be iterated without copying them.
+ **	getSnapshot() shares the current list of functions with the caller; the list is only copied if the
+ **	registry is changed while a snapshot exists (copy on write), e.g. if a listener registers or removes
+ **	a listener while it is called. As for Util::Registry::getElementsCopy(), all functions of a snapshot
+ **	are called even if they are removed in the meantime, and functions added in the meantime are not called.
+ **/
+template<typename function_t>
+class ListenerRegistry{
+	private:
+		struct Elements{
+			std::vector<uint64_t> ids;	//!< ascending
+			std::vector<function_t> functions;
+		};
+		std::shared_ptr<Elements> elements;
+		uint64_t lastId;
+
+		//! (internal) Make sure that no snapshot shares the elements.
+		Elements & getWritableElements(){
+			if(!elements)
+				elements = std::make_shared<Elements>();
+			else if(elements.use_count()>1)
+				elements = std::make_shared<Elements>(*elements);
+			return *elements;
+		}
+
+	public:
+		typedef function_t element_t;
+
+		//! Handle of a registered function; it is only valid for the registry that created it.
+		class handle_t{
+				friend class ListenerRegistry;
+				uint64_t id;
+				explicit handle_t(uint64_t _id) : id(_id) {}
+			public:
+				handle_t() : id(0) {}
+		};
+
+		//! Shared, immutable list of the functions registered at the time of its creation.
+		class Snapshot{
+				std::shared_ptr<const Elements> elements;
+				const std::vector<function_t> & getFunctions()const{
+					static const std::vector<function_t> noFunctions;
+					return elements ? elements->functions : noFunctions;
+				}
+			public:
+				typedef typename std::vector<function_t>::const_iterator const_iterator;
+				explicit Snapshot(std::shared_ptr<const Elements> _elements) : elements(std::move(_elements)) {}
+
+				const_iterator begin()const		{	return getFunctions().begin();	}
+				const_iterator end()const		{	return getFunctions().end();	}
+				bool empty()const				{	return getFunctions().empty();	}
+				size_t size()const				{	return getFunctions().size();	}
+		};
+
+		ListenerRegistry() : lastId(0) {}
+
+		handle_t registerElement(function_t fun){
+			Elements & e = getWritableElements();
+			e.ids.push_back(++lastId);
+			e.functions.push_back(std::move(fun));
+			return handle_t(lastId);
+		}
+
+		//! Remove the function registered with the given handle; unknown handles are ignored.
+		void unregisterElement(handle_t handle){
+			if(!elements)
+				return;
+			const auto it = std::lower_bound(elements->ids.begin(),elements->ids.end(),handle.id);
+			if(it==elements->ids.end() || *it!=handle.id)
+				return;
+			const size_t index = static_cast<size_t>(it-elements->ids.begin());
+			Elements & e = getWritableElements();
+			e.ids.erase(e.ids.begin()+index);
+			e.functions.erase(e.functions.begin()+index);
+		}
+
+		bool empty()const					{	return !elements || elements->ids.empty();	}
+		size_t size()const					{	return elements ? elements->ids.size() : 0;	}
+
+		//! Returns the currently registered functions without copying them.
+		Snapshot getSnapshot()const			{	return Snapshot(elements);	}
+};
+
+}
+
+#endif // GUI_LISTENER_REGISTRY_H
@@ -23,6 +23,11 @@ StyleManager::~StyleManager() = default;
 // colors
 
 Util::Color4ub StyleManager::getColor(propertyId_t type)const{
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->colors.size() || stacks->colors[type].empty())
+			return Colors::NO_COLOR;
+		return stacks->colors[type].back();
+	}
 	if(type>=colorRegistry.size())
 		return Colors::NO_COLOR;
 	const colorStack_t & stack(colorRegistry[type]);
@@ -38,12 +43,25 @@ void StyleManager::initColors(size_t newSize){
 }
 
 void StyleManager::pushColor(propertyId_t type,const Util::Color4ub & c){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->colors.size())
+			stacks->colors.resize(type+1,std::vector<Util::Color4ub>(1,Colors::NO_COLOR));
+		stacks->colors[type].push_back(c);
+		return;
+	}
 	if(type>=colorRegistry.size())
 		initColors(type+1);
 	colorRegistry[type].push_back(c);
 }
 
 void StyleManager::popColor(propertyId_t type){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->colors.size() || stacks->colors[type].size()<=1)
+			WARN("Empty property stack.");
+		else
+			stacks->colors[type].pop_back();
+		return;
+	}
 	if(type>=colorRegistry.size() || colorRegistry[type].size()<=1){
 		WARN("Empty property stack.");
 	}else{
@@ -74,6 +92,13 @@ AbstractFont * StyleManager::getDefaultFont(propertyId_t type)const{
 }
 
 AbstractFont * StyleManager::getFont(propertyId_t type)const{
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->fonts.size() || stacks->fonts[type].empty() || stacks->fonts[type].back()==nullptr){
+			WARN("No Font!");
+			return nullptr;
+		}
+		return stacks->fonts[type].back();
+	}
 	if(type>=fontRegistry.size()){
 		WARN("No Font!");
 		return nullptr;
@@ -95,12 +120,25 @@ void StyleManager::initFonts(size_t newSize){
 }
 
 void StyleManager::pushFont(propertyId_t type,AbstractFont * f){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->fonts.size())
+			stacks->fonts.resize(type+1,std::vector<AbstractFont *>(1,nullptr));
+		stacks->fonts[type].push_back(f);
+		return;
+	}
 	if(type>=fontRegistry.size())
 		initFonts(type+1);
 	fontRegistry[type].push_back(f);
 }
 
 void StyleManager::popFont(propertyId_t type){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->fonts.size() || stacks->fonts[type].size()<=1)
+			WARN("Empty font stack.");
+		else
+			stacks->fonts[type].pop_back();
+		return;
+	}
 	if(type>=fontRegistry.size() || fontRegistry[type].size()<=1){
 		WARN("Empty font stack.");
 	}else{
@@ -150,6 +188,11 @@ void StyleManager::initShapes(size_t newSize){
 }
 
 AbstractShape * StyleManager::getShape(propertyId_t type)const{
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->shapes.size() || stacks->shapes[type].empty())
+			return NullShape::instance();
+		return stacks->shapes[type].back();
+	}
 	if(type>=shapeRegistry.size())
 		return NullShape::instance();
 	const shapeStack_t & stack(shapeRegistry[type]);
@@ -157,6 +200,12 @@ AbstractShape * StyleManager::getShape(propertyId_t type)const{
 }
 
 void StyleManager::pushShape(propertyId_t type,AbstractShape * s){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->shapes.size())
+			stacks->shapes.resize(type+1,std::vector<AbstractShape *>(1,NullShape::instance()));
+		stacks->shapes[type].push_back(s);
+		return;
+	}
 	if(type>=shapeRegistry.size())
 		initShapes(type+1);
 	shapeRegistry[type].push_back(s);
@@ -164,6 +213,13 @@ void StyleManager::pushShape(propertyId_t type,AbstractShape * s){
 }
 
 void StyleManager::popShape(propertyId_t type){
+	if(ThreadStacks * stacks = getThreadStacks()){
+		if(type>=stacks->shapes.size() || stacks->shapes[type].size()<=1)
+			WARN("Empty shape stack.");
+		else
+			stacks->shapes[type].pop_back();
+		return;
+	}
 	if(type>=shapeRegistry.size() || shapeRegistry[type].size()<=1){
 		WARN("Empty shape stack.");
 	}else{
@@ -191,6 +247,43 @@ void StyleManager::setGlobalValue(propertyId_t type,float value){
 }
 
 
+//------------------------------------------------------
+// thread-confined stacks
+
+thread_local const StyleManager * StyleManager::threadStacksOwner = nullptr;
+thread_local StyleManager::ThreadStacks * StyleManager::threadStacks = nullptr;
+
+StyleManager::ThreadStacks StyleManager::createThreadStacks()const{
+	ThreadStacks stacks;
+	stacks.colors = colorRegistry;
+	stacks.fonts.reserve(fontRegistry.size());
+	for(const auto & fontStack : fontRegistry){
+		stacks.fonts.emplace_back();
+		for(const auto & font : fontStack)
+			stacks.fonts.back().push_back(font.get());
+	}
+	stacks.shapes.reserve(shapeRegistry.size());
+	for(const auto & shapeStack : shapeRegistry){
+		stacks.shapes.emplace_back();
+		for(const auto & shape : shapeStack)
+			stacks.shapes.back().push_back(shape.get());
+	}
+	return stacks;
+}
+
+//! (ctor)
+StyleManager::ThreadScope::ThreadScope(const StyleManager & styleManager,const ThreadStacks & _stacks) :
+		previousOwner(threadStacksOwner), previousStacks(threadStacks), stacks(_stacks) {
+	threadStacksOwner = &styleManager;
+	threadStacks = &stacks;
+}
+
+//! (dtor)
+StyleManager::ThreadScope::~ThreadScope(){
+	threadStacksOwner = previousOwner;
+	threadStacks = previousStacks;
+}
+
 //------------------------------------------------------
 
 }
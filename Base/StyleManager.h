@@ -122,6 +122,42 @@ class StyleManager{
 		void setGlobalValue(propertyId_t type,float v);
 	//	@}
 
+	// ----------------------------------------------------------------
+
+	/*!	@name Thread-confined property stacks
+		A thread can push and pop the colors, fonts and shapes on its own copy of the property stacks
+		(used by the parallel layout, see GUI_Manager::setNumberOfLayoutThreads(...)).
+		The copies hold plain pointers, as the fonts and shapes are kept alive by the shared stacks
+		and by the pushing properties. The defaults and global values must not be changed while copies are used.	*/
+	// @{
+	public:
+		struct ThreadStacks{
+			std::vector<std::vector<Util::Color4ub>> colors;
+			std::vector<std::vector<AbstractFont *>> fonts;
+			std::vector<std::vector<AbstractShape *>> shapes;
+		};
+		//! Copy the current state of the shared stacks.
+		ThreadStacks createThreadStacks()const;
+
+		//! While an instance exists, the calling thread uses its own copy of the given stacks.
+		class ThreadScope{
+			public:
+				ThreadScope(const StyleManager & styleManager,const ThreadStacks & stacks);
+				~ThreadScope();
+				ThreadScope(const ThreadScope &) = delete;
+				ThreadScope & operator=(const ThreadScope &) = delete;
+			private:
+				const StyleManager * previousOwner;
+				ThreadStacks * previousStacks;
+				ThreadStacks stacks;
+		};
+	private:
+		static thread_local const StyleManager * threadStacksOwner;
+		static thread_local ThreadStacks * threadStacks;
+		//! Returns the stacks of the calling thread or nullptr if the shared stacks are used.
+		ThreadStacks * getThreadStacks()const	{	return threadStacksOwner==this ? threadStacks : nullptr;	}
+	//	@}
+
 
 };
 
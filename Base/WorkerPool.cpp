@@ -0,0 +1,93 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "WorkerPool.h"
+
+namespace GUI {
+
+//! (ctor)
+WorkerPool::WorkerPool(uint32_t numWorkers) :
+		tasks(nullptr), nextTask(0), batchNumber(0), busyWorkers(0), shutdown(false) {
+	workers.reserve(numWorkers);
+	for(uint32_t i = 0; i<numWorkers; ++i)
+		workers.emplace_back(&WorkerPool::run,this);
+}
+
+//! (dtor)
+WorkerPool::~WorkerPool(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shutdown = true;
+	}
+	batchStarted.notify_all();
+	for(auto & worker : workers)
+		worker.join();
+}
+
+void WorkerPool::execute(const std::vector<task_t> & newTasks){
+	if(newTasks.empty())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks = &newTasks;
+		nextTask = 0;
+		firstException = nullptr;
+		busyWorkers = static_cast<uint32_t>(workers.size());
+		++batchNumber;
+	}
+	batchStarted.notify_all();
+	executeTasks();
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		batchFinished.wait(lock,[this](){	return busyWorkers==0;	});
+		tasks = nullptr;
+		exception = firstException;
+		firstException = nullptr;
+	}
+	if(exception)
+		std::rethrow_exception(exception);
+}
+
+//! (internal) Main loop of a worker thread.
+void WorkerPool::run(){
+	uint64_t lastBatch = 0;
+	while(true){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			batchStarted.wait(lock,[this,lastBatch](){	return shutdown || batchNumber!=lastBatch;	});
+			if(shutdown)
+				return;
+			lastBatch = batchNumber;
+		}
+		executeTasks();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--busyWorkers;
+		}
+		batchFinished.notify_all();
+	}
+}
+
+//! (internal) Execute tasks of the current batch until all have been taken.
+void WorkerPool::executeTasks(){
+	for(size_t i = nextTask++; i<tasks->size(); i = nextTask++){
+		try{
+			(*tasks)[i]();
+		}catch(...){
+			std::lock_guard<std::mutex> lock(mutex);
+			if(!firstException)
+				firstException = std::current_exception();
+		}
+	}
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_WORKER_POOL_H
+#define GUI_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GUI {
+
+/***
+ **	WorkerPool
+ **	Fixed set of threads executing batches of independent tasks (e.g. the layout of the top-level windows).
+ **/
+class WorkerPool{
+	public:
+		typedef std::function<void ()> task_t;
+
+		//! Starts @p numWorkers threads.
+		explicit WorkerPool(uint32_t numWorkers);
+		~WorkerPool();
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool & operator=(const WorkerPool &) = delete;
+
+		uint32_t getNumberOfWorkers()const		{	return static_cast<uint32_t>(workers.size());	}
+
+		/*! Execute all tasks (in arbitrary order) and return when all are finished.
+			The calling thread executes tasks as well. If tasks throw exceptions, the first one is
+			rethrown after all tasks are finished.	*/
+		void execute(const std::vector<task_t> & tasks);
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable batchStarted;
+		std::condition_variable batchFinished;
+		const std::vector<task_t> * tasks;
+		std::atomic<size_t> nextTask;
+		uint64_t batchNumber;
+		uint32_t busyWorkers;
+		bool shutdown;
+		std::exception_ptr firstException;
+
+		void run();
+		void executeTasks();
+};
+
+}
+
+#endif // GUI_WORKER_POOL_H
@@ -14,23 +14,28 @@
 #include "../Base/ListenerHelper.h"
 #include "../Base/Draw.h"
 #include "../Base/Layouters/ExtLayouter.h"
+#include "../Base/LayoutProfiler.h"
 #include "ComponentTooltipFeature.h"
 #include "../GUI_Manager.h"
 #include "Container.h"
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace GUI{
 
 //! (ctor)
 Component::Component(GUI_Manager & _gui,flag_t _flags/*=0*/)
-		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),prev(nullptr),next(nullptr),flags(_flags) { 
+		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),indexInParent(0),flags(_flags),typeTags(0),
+		absPositionGeneration(0),parentAbsPositionGeneration(0),absPositionCheckedEpoch(0) { 
 }
 
 //! (ctor)
 Component::Component(GUI_Manager & _gui,const Geometry::Rect & _relRect,flag_t _flags/*=0*/)
-		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),prev(nullptr),next(nullptr),flags(_flags) {
+		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),indexInParent(0),flags(_flags),typeTags(0),
+		absPositionGeneration(0),parentAbsPositionGeneration(0),absPositionCheckedEpoch(0) {
 	setRect(_relRect);
 	//ctor
 }
@@ -45,56 +50,94 @@ Component::~Component() {
 
 //! (static)
 void Component::destroy(Component * component){
+	destroy(std::vector<Ref>(1,component));
+}
+
+//! (static)
+void Component::destroy(const std::vector<Ref> & roots){
 	struct MyVisitor : public Component::Visitor {
-			std::vector<Util::Reference<Component> > components;
+			std::vector<Ref> components;
+			std::unordered_set<const Component *> componentSet;
 			// ---|>  Component::Visitor
 			visitorResult_t visit(Component & c) override {
-				components.push_back(&c);
+				if(componentSet.insert(&c).second)
+					components.push_back(&c);
 				return Component::CONTINUE_TRAVERSAL;
 			}
 	}visitor;
 
-	component->traverseSubtree(visitor);
-	for(auto & c : visitor.components){
-//		(*it)->setParent(nullptr);
+	std::vector<GUI_Manager *> guis;
+	for(const auto & root : roots){
+		if(root.isNull())
+			continue;
+		root->traverseSubtree(visitor);
+		if(std::find(guis.begin(),guis.end(),&root->getGUI())==guis.end())
+			guis.push_back(&root->getGUI());
+	}
+
+	// detach the roots from their (remaining) parents; one bulk removal per parent
+	std::unordered_map<Container *,std::vector<Ref>> removalsPerParent;
+	for(const auto & c : visitor.components){
+		Container * parent = c->getParent();
+		if(parent!=nullptr && visitor.componentSet.count(parent)==0)
+			removalsPerParent[parent].push_back(c);
+	}
+	for(const auto & entry : removalsPerParent)
+		entry.first->_removeChildren(entry.second);
+
+	// dissolve the subtrees
+	for(const auto & c : visitor.components){
+		Container * container = component_cast<Container>(c.get());
+		if(container!=nullptr && !container->getChildren().empty()){
+			const Container::children_t children(container->getChildren());
+			container->_removeChildren(children);
+		}
 		c->removeAttributes();
 		c->clearProperties();
-		if(c->hasParent())
-			c->getParent()->_removeChild(c);
 		c->setFlag(DESTROYED,true);
 	}
+	for(GUI_Manager * gui : guis)
+		gui->removeComponentListeners(visitor.componentSet);
+	// the components that are not referenced elsewhere are deleted when visitor.components is released
 }
 
-//! (internal)
-void Component::_updateNeighbors(const Ref & newPrev,const Ref & newNext){
-	const Ref oldPrev=getPrev();
-	const Ref oldNext=getNext();
-
-	setPrev(newPrev);
-	setNext(newNext);
-
-	if(newPrev.isNotNull())
-		newPrev->setNext(this);
-
-	if(newNext.isNotNull())
-		newNext->setPrev(this);
-
-	if(oldPrev.isNotNull())
-		oldPrev->setNext(oldNext);
+Component * Component::getNext()const{
+	const Container * p = getParent();
+	return p==nullptr ? nullptr : p->getChild(indexInParent+1);
+}
 
-	if(oldNext.isNotNull())
-		oldNext->setPrev(oldPrev);
+Component * Component::getPrev()const{
+	const Container * p = getParent();
+	return (p==nullptr || indexInParent==0) ? nullptr : p->getChild(indexInParent-1);
 }
 
 Geometry::Vec2 Component::getAbsPosition() {
-	if (isAbsPosValid()) {
-		return Geometry::Vec2(absPosition);
+	const uint32_t epoch = getGUI().getAbsPositionEpoch();
+	if (isAbsPosValid() && absPositionCheckedEpoch==epoch) {
+		return absPosition;
 	}
-	absPosition = getPosition();
-	if (hasParent()) {
-		absPosition+=getParent()->getAbsPosition();
+	Container * p = getParent();
+	if(p==nullptr){ // a root only depends on its own position; this is also not written by the parallel layout
+		if(!isAbsPosValid()){
+			absPosition = getPosition();
+			++absPositionGeneration;
+			setFlag(ABS_POSITION_VALID,true);
+		}
+		return absPosition;
+	}
+	// validate the parent first; it is checked at most once per epoch as well.
+	const Geometry::Vec2 parentPos = p!=nullptr ? p->getAbsPosition() : Geometry::Vec2();
+	const uint32_t parentGeneration = p!=nullptr ? p->absPositionGeneration : 0;
+	if (!isAbsPosValid() || parentGeneration!=parentAbsPositionGeneration) {
+		const Geometry::Vec2 newAbsPosition = getPosition()+parentPos;
+		if(newAbsPosition!=absPosition || !isAbsPosValid()){
+			absPosition = newAbsPosition;
+			++absPositionGeneration;
+		}
+		parentAbsPositionGeneration = parentGeneration;
+		setFlag(ABS_POSITION_VALID,true);
 	}
-	setFlag(ABS_POSITION_VALID,true);
+	absPositionCheckedEpoch = epoch;
 	return absPosition;
 }
 
@@ -133,20 +176,14 @@ void Component::disable() {
 }
 
 void Component::invalidateAbsPosition() {
-	if(isAbsPosValid()){
-		struct MyVisitor : public Component::Visitor {
-			// ---|> Component::Visitor
-			visitorResult_t visit(Component & c) override {
-				if (!c.isAbsPosValid()) {
-					return Component::BREAK_TRAVERSAL;
-				} else {
-					c.setFlag(Component::ABS_POSITION_VALID,false);
-				}
-				return Component::CONTINUE_TRAVERSAL;
-			}
-		}visitor;
-		traverseSubtree(visitor);
-	}
+	invalidateHitTestIndex();
+	setFlag(ABS_POSITION_VALID,false);
+	getGUI()._nextAbsPositionEpoch();
+}
+
+//! (internal) A top-level component layouted by the parallel layout reports its rect changes afterwards.
+bool Component::isLayoutedInParallel()const{
+	return getGUI().isParallelLayoutRunning() && hasParent() && !getParent()->hasParent();
 }
 
 void Component::setRect(const Geometry::Rect & newRect) {
@@ -162,7 +199,7 @@ void Component::setRect(const Geometry::Rect & newRect) {
 		//	traverseChildren(visitor); // this is not enough for certain nested layouts
 		invalidateSubtreeLayout();
 
-		if(hasParent())
+		if(hasParent() && !isLayoutedInParallel())
 			parent->childRectChanged(this);
 		invalidateLayout();
 		invalidateRegion(); // invalidate new rect
@@ -171,7 +208,7 @@ void Component::setRect(const Geometry::Rect & newRect) {
 		relRect = newRect;
 
 		invalidateAbsPosition();
-		if(hasParent())
+		if(hasParent() && !isLayoutedInParallel())
 			parent->childRectChanged(this);
 		invalidateRegion(); // invalidate new rect
 	}
@@ -389,67 +426,134 @@ void Component::removeTooltip()						{	removeComponentTooltip(*this);	}
 // -----------------------------------
 // ---- Layout
 
+//! (internal)
+static void applyLayouter(AbstractLayouter & layouter,Component * c,LayoutProfiler * profiler){
+	if(profiler==nullptr){
+		layouter.layout(c);
+	}else{
+		profiler->_beginStep(layouter.getTypeName());
+		layouter.layout(c);
+		profiler->_endStep();
+	}
+}
+
+/*! (internal) Number of layouts given up on this thread (see layout()).
+	\note A component and its subtree are always layouted by the same thread.	*/
+static thread_local uint32_t numberOfAbortedLayouts = 0;
+
 uint32_t Component::layout(){
+	const uint32_t abortedLayoutsBefore = numberOfAbortedLayouts;
+	LayoutProfiler * profiler = getGUI().getLayoutProfiler();
+	if(profiler!=nullptr)
+		profiler->_beginLayout(*this);
 		// enable display properties
 	for(auto & prop : recursiveDisplayProperties)
 		getGUI().enableProperty(prop);
-		
-	const bool wasValid = getFlag(LAYOUT_VALID);
-	setFlag(LAYOUT_VALID,true);
-	
+	setFlag(LAYOUT_IN_PROGRESS,true);
+
 	uint32_t count = 0;
-	
-	if(!getFlag(SUBTREE_LAYOUT_VALID)){
-		setFlag(SUBTREE_LAYOUT_VALID,true);
-		count += layoutChildren();
-	}
-		
-	if(!wasValid || !getFlag(LAYOUT_VALID)){
-		
-		for(auto & layouter : layouters)
-			layouter->layout(this);
+	bool layoutByChildren = !getFlag(LAYOUT_VALID);
+	setFlag(LAYOUT_VALID,true);
 
+	// 1. rect depending on the parent; the parent's rect is already final
+	if(layoutByChildren){
+		for(auto & layouter : layouters){
+			if(layouter->getDependency()==AbstractLayouter::DEPENDS_ON_PARENT)
+				applyLayouter(*layouter,this,profiler);
+		}
 		// \note external layouter should not be used in combination with AUTO_MAXIMIZE
 		if (getFlag(AUTO_MAXIMIZE)){ // deprecated!
 			if (hasParent()) {
 				setRect( getParent()->getInnerRect() );
 			}
 		}
+	}
 
-		enableLocalDisplayProperties();
-		doLayout();
-		disableLocalDisplayProperties();
-
-//		if(!getFlag(SUBTREE_LAYOUT_VALID)){
-//			setFlag(SUBTREE_LAYOUT_VALID,true);
-//			count += layoutChildren();
-//		}
-		++count;
+	for(uint32_t iteration = 1; ; ++iteration){
+		if(profiler!=nullptr)
+			profiler->_beginIteration();
+		// 2. children
+		if(!getFlag(SUBTREE_LAYOUT_VALID)){
+			setFlag(SUBTREE_LAYOUT_VALID,true);
+			count += layoutChildren();
+		}
+		// 3. layout depending on the children (which may have been changed in step 2)
+		if(!getFlag(LAYOUT_VALID) || layoutByChildren){
+			setFlag(LAYOUT_VALID,true);
+			layoutByChildren = false;
+			for(auto & layouter : layouters){
+				if(layouter->getDependency()==AbstractLayouter::DEPENDS_ON_CHILDREN)
+					applyLayouter(*layouter,this,profiler);
+			}
+			if(profiler!=nullptr)
+				profiler->_beginStep("doLayout");
+			enableLocalDisplayProperties();
+			doLayout();
+			disableLocalDisplayProperties();
+			if(profiler!=nullptr)
+				profiler->_endStep();
+			++count;
+		}
+		if(getFlag(LAYOUT_VALID) && getFlag(SUBTREE_LAYOUT_VALID))
+			break;
+		// cyclic dependency; try again in the next frame. If a descendant has been given up, repeating would repeat its iterations.
+		if(iteration>=MAX_LAYOUT_ITERATIONS || numberOfAbortedLayouts!=abortedLayoutsBefore){
+			++numberOfAbortedLayouts;
+			getGUI()._layoutDidNotConverge(this);
+			break;
+		}
 	}
+	setFlag(LAYOUT_IN_PROGRESS,false);
+
 	// disable display properties
 	for(auto & prop : recursiveDisplayProperties)
 		getGUI().disableProperty(prop);	
+	if(profiler!=nullptr)
+		profiler->_endLayout();
 	return count;
 }
 
 
 void Component::invalidateLayout(){
+	if(getGUI().getLayoutProfiler()!=nullptr)
+		getGUI().getLayoutProfiler()->_layoutInvalidated(*this,getFlag(LAYOUT_VALID));
 	setFlag(LAYOUT_VALID,false);
-	for(Container * c=getParent();c!=nullptr && c->getFlag(SUBTREE_LAYOUT_VALID) ;c=c->getParent()){
+	/* Mark the ancestors, so that the next layout pass reaches this component. The ancestors of a component
+		whose layout is currently running are not marked, as it repeats its layout anyway (see layout()).	*/
+	for(Component * c=this; !c->getFlag(LAYOUT_IN_PROGRESS) && c->hasParent() && c->getParent()->getFlag(SUBTREE_LAYOUT_VALID); ){
+		c = c->getParent();
 		c->setFlag(SUBTREE_LAYOUT_VALID,false);
 	}
+	invalidateHitTestIndex();
+}
+
+//! (internal) A component without the flag is not indexed or its window's index is already invalid.
+void Component::invalidateHitTestIndex(){
+	getGUI()._nextHitTestGeneration();
+	for(Component * c=this;c!=nullptr && c->getFlag(HIT_TEST_INDEX_VALID) ;c=c->getParent()){
+		c->setFlag(HIT_TEST_INDEX_VALID,false);
+	}
 }
 
 void Component::invalidateSubtreeLayout(){
 	struct MyVisitor:public Component::Visitor {
+		const Component * root;
+		LayoutProfiler * profiler;
+		MyVisitor(const Component * _root,LayoutProfiler * _profiler) : Visitor(), root(_root), profiler(_profiler) {}
 		// ---|> Component::Visitor
 		visitorResult_t visit(Component & c) override {
+			// the flags are cleared directly, so the re-dirtied descendants are reported to the profiler here
+			if(profiler!=nullptr && &c!=root && c.getFlag(LAYOUT_VALID))
+				profiler->_layoutInvalidated(c,true);
 			c.setFlag(LAYOUT_VALID,false);
 			c.setFlag(SUBTREE_LAYOUT_VALID,false);
 			return Component::CONTINUE_TRAVERSAL;
 		}
-	}visitor;
+	}visitor(this,getGUI().getLayoutProfiler());
+	const bool wasValid = getFlag(LAYOUT_VALID);
 	traverseSubtree(visitor);
+	if(visitor.profiler!=nullptr)
+		visitor.profiler->_layoutInvalidated(*this,wasValid);
 	invalidateLayout();
 }
 
@@ -13,6 +13,7 @@
 
 #include "../Base/Layouters/AbstractLayouter.h"
 #include "../Base/AbstractProperty.h"
+#include "../Base/ComponentAllocator.h"
 
 #include <Geometry/Rect.h>
 #include <Geometry/Vec2.h>
@@ -38,6 +39,7 @@ class GUI_Manager;
  **/
 class Component: public Util::AttributeProvider, public Util::ReferenceCounter<Component> {
 		PROVIDES_TYPE_NAME(Component)
+		PROVIDES_POOLED_ALLOCATION()
 
 	/*!	@name Main	*/
 	// @{
@@ -56,6 +58,10 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		}
 
 		static void destroy(Component * c);
+		/*! Destroy the subtrees of all given components at once (the subtrees may overlap).
+			Each parent is updated only once, the listeners of all destroyed components are removed
+			in a single pass over the listener maps and unreferenced components are deleted at the end.	*/
+		static void destroy(const std::vector<Ref> & components);
 
 		// ---o
 		virtual std::string toString()const;
@@ -67,21 +73,20 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 	// @{
 	private:
 		Util::WeakPointer<Container> parent;
-		Ref prev;
-		Ref next;
-	protected:
-		void setNext(const Ref & newNext)	{	next=newNext;	}
-		void setPrev(const Ref & newPrev)	{	prev=newPrev;	}
+		size_t indexInParent; //!< position in the parent's child vector (only valid if the component has a parent)
 
 	public:
-		void _setParent(const Util::WeakPointer<Container> & c) 	{	parent = c;	invalidateLayout(); };
-		void _updateNeighbors(const Ref & newPrev,const Ref & newNext);
+		void _setParent(const Util::WeakPointer<Container> & c) 	{	parent = c;	invalidateLayout();	invalidateAbsPosition(); };
+		void _setIndexInParent(size_t i)							{	indexInParent = i;	}
+		size_t _getIndexInParent()const								{	return indexInParent;	}
 
 		void bringToFront();
 
 		Container * getParent()const		{	return parent.get();	}
-		Component * getNext()const			{	return next.get();	}
-		Component * getPrev()const			{	return prev.get();	}
+		//! The following sibling or nullptr; O(1), as the parent stores its children contiguously.
+		Component * getNext()const;
+		//! The preceding sibling or nullptr.
+		Component * getPrev()const;
 		bool hasParent()const				{	return !parent.isNull();	}
 	// @}
 
@@ -109,6 +114,8 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		static const flag_t LOCKED=1<<13; //!< Input components are read only.
 		static const flag_t HAS_MOUSECURSOR_PROPERTY=1<<14;
 		// status
+		static const flag_t LAYOUT_IN_PROGRESS=1<<17; //!< layout() of the component is currently running.
+		static const flag_t HIT_TEST_INDEX_VALID=1<<18; //!< The component is contained in the current hit test index of its window (see GUI_Manager::getComponentAtPos).
 		static const flag_t DESTROYED=1<<19;
 		static const flag_t ABS_POSITION_VALID=1<<20;
 		static const flag_t LAYOUT_VALID=1<<21;
@@ -139,6 +146,30 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 
 	// -----------------------------------
 
+	/*!	@name Type classification
+		Cheap alternative to dynamic_cast for component types that are tested in loops (see component_cast).
+		A tagged class adds its tag in its constructors; the tags of its base classes are kept.	*/
+	// @{
+	public:
+		typedef uint32_t typeTag_t;
+		static const typeTag_t TYPE_CONTAINER=1<<0;
+		static const typeTag_t TYPE_CONNECTOR=1<<1;
+		static const typeTag_t TYPE_MENU=1<<2;
+		static const typeTag_t TYPE_NEXT_ROW=1<<3;
+		static const typeTag_t TYPE_NEXT_COLUMN=1<<4;
+		static const typeTag_t TYPE_TAB=1<<5;
+		static const typeTag_t TYPE_TABBED_PANEL=1<<6;
+		static const typeTag_t TYPE_SCROLLABLE_CONTAINER=1<<7;
+
+		bool hasTypeTag(typeTag_t t)const	{	return (typeTags&t)==t;	}
+	protected:
+		void addTypeTag(typeTag_t t)		{	typeTags |= t;	}
+	private:
+		typeTag_t typeTags;
+	 // @}
+
+	// -----------------------------------
+
 	/*!	@name Layout	*/
 	// @{
 	private:
@@ -166,9 +197,26 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		void invalidateLayout();
 		void invalidateSubtreeLayout();
 
-		/*! The size of the component is set correctly (if necessary) and all children are layouted recursivly. */
+		//! Maximal number of times a component's children and own layout are repeated in a single call of layout().
+		static const uint32_t MAX_LAYOUT_ITERATIONS = 8;
+
+		/*! The size of the component is set correctly (if necessary) and all children are layouted recursivly.
+			The layout is done in dependency order within a single pass:
+			 1. The layouters depending on the parent (see AbstractLayouter::getDependency()) and AUTO_MAXIMIZE;
+				the parent's rect is already final when its children are layouted.
+			 2. The invalid children.
+			 3. The layouters depending on the children and doLayout().
+			If the children or the component are invalidated again by this (e.g. a size determined by the children
+			changes the size of a child that depends on the parent), steps 2 and 3 are repeated. If this does not
+			converge within MAX_LAYOUT_ITERATIONS iterations, the sizes depend on each other cyclically; the component
+			is reported to the GUI_Manager and layouted again in the next frame.
+			If a descendant has been given up, the component's layout is not repeated either (but reported as well),
+			so that a cyclic dependency costs at most MAX_LAYOUT_ITERATIONS layouts per component and frame instead of
+			multiplying with the depth of the tree.
+			Returns the number of components whose own layout has been executed.	*/
 		uint32_t layout();
-		uint32_t layoutChildren();
+		// ---o
+		virtual uint32_t layoutChildren();
 		
 		void removeLayouter(Util::WeakPointer<AbstractLayouter> layouter);
 		
@@ -182,6 +230,8 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 			}
 			return false;
 		}
+	private:
+		bool isLayoutedInParallel()const;
 	// @}
 
 	// -----------------------------------
@@ -229,12 +279,23 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 	private:
 		Geometry::Vec2 absPosition;
 		Geometry::Rect relRect;
+		/*! The cached absolute position is validated lazily: it is recalculated if the own position has changed
+			(ABS_POSITION_VALID is cleared) or if the parent's absPositionGeneration differs from parentAbsPositionGeneration.
+			The check is done at most once per GUI_Manager::getAbsPositionEpoch().	*/
+		uint32_t absPositionGeneration;			//!< incremented whenever absPosition changes
+		uint32_t parentAbsPositionGeneration;	//!< the parent's absPositionGeneration used for absPosition
+		uint32_t absPositionCheckedEpoch;		//!< the epoch in which absPosition was last validated
 		bool isAbsPosValid()const							{	return getFlag(ABS_POSITION_VALID);	}
+		void invalidateHitTestIndex();
 
 	public:
 		bool coversAbsPosition(const Geometry::Vec2 & p)	{	return coversLocalPosition(p-getAbsPosition());	}
 		// ---o
 		virtual bool coversLocalPosition(const Geometry::Vec2 & localPos);
+		/*! ---o
+			The local rectangle outside of which coversLocalPosition(...) is always false.
+			It is used to find the candidates for getComponentAtPos(...) in the GUI_Manager's spatial index.	*/
+		virtual Geometry::Rect getHitTestRect()const		{	return getLocalRect();	}
 
 		Geometry::Vec2 getAbsPosition();
 		Geometry::Rect getAbsRect()							{	return Geometry::Rect(getAbsPosition(),relRect.getSize());	}
@@ -251,6 +312,8 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		Geometry::Vec2 getPosition()const					{	return relRect.getPosition();	}
 		float getWidth()const								{	return relRect.getWidth();	}
 
+		/*! Mark the component's position as changed. This is O(1); the absolute positions of the
+			children are updated when they are requested.	*/
 		void invalidateAbsPosition();
 		// ---o
 		virtual void invalidateRegion();
@@ -340,7 +403,17 @@ public:
 
 };
 
+//! Type tag of a component class; specialized for all classes that add a type tag.
+template<class T> struct ComponentTypeTag;
 
+/*! Returns @p c as T if it is a T (or a subclass of T) and nullptr otherwise.
+	Like dynamic_cast, but only a flag test. T needs a ComponentTypeTag<T> specialization.	*/
+template<class T> T * component_cast(Component * c){
+	return (c!=nullptr && c->hasTypeTag(ComponentTypeTag<T>::value)) ? static_cast<T*>(c) : nullptr;
+}
+template<class T> const T * component_cast(const Component * c){
+	return (c!=nullptr && c->hasTypeTag(ComponentTypeTag<T>::value)) ? static_cast<const T*>(c) : nullptr;
+}
 
 }
 
@@ -68,7 +68,8 @@ class GUI::HoverPropertyHandler {
 					
 					hoverPropertyLayer_t usedLayersMask = 0;
 					
-					for(Component* c=gui.getComponentAtPos(Geometry::Vec2(motionEvent.x, motionEvent.y)); c; c=c->getParent()){
+					for(const auto & hitComponent : gui.getHitPath(Geometry::Vec2(motionEvent.x, motionEvent.y))){
+						Component * c = hitComponent.get();
 						auto* attr = getContainerAttribute(*c);
 						if(attr){
 							const hoverPropertyLayer_t oldUsedLayersMask = usedLayersMask;
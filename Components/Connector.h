@@ -32,6 +32,7 @@ class Connector: public Container{
 		// ---|> Component
 		void doLayout() override;
 		bool coversLocalPosition(const Geometry::Vec2 & pos) override;
+		Geometry::Rect getHitTestRect()const override	{	return getLocalRect().changeSizeCentered(10,10);	}
 	private:
 		// ---|> Component
 		void doDisplay(const Geometry::Rect & region) override;
@@ -65,5 +66,7 @@ class Connector: public Container{
 		Util::Reference<Component> secondComponent;
 
 };
+
+template<> struct ComponentTypeTag<Connector>{	static const Component::typeTag_t value = Component::TYPE_CONNECTOR;	};
 }
 #endif // GUI_Connector_H
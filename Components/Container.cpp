@@ -10,99 +10,75 @@
 */
 #include "Container.h"
 #include "../GUI_Manager.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 namespace GUI {
 
 //! (ctor)
 Container::Container(GUI_Manager & _gui,flag_t _flags/*=0*/) :
-		Component(_gui,_flags),contentsCount(0) {
-	//ctor
+		Component(_gui,_flags),childrenExtentValid(false),cullingAxis(CULLING_UNSORTED),cullingIndexValid(false) {
+	addTypeTag(TYPE_CONTAINER);
 }
 
 //! (ctor)
 Container::Container(GUI_Manager & _gui,const Geometry::Rect & _r,flag_t _flags/*=0*/) :
-		Component(_gui,_r,_flags),contentsCount(0) {
-	//ctor
+		Component(_gui,_r,_flags),childrenExtentValid(false),cullingAxis(CULLING_UNSORTED),cullingIndexValid(false) {
+	addTypeTag(TYPE_CONTAINER);
 }
 
 //! (dtor)
 Container::~Container() {
-	std::vector<Ref> refHolders;
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
-		refHolders.push_back(c);
-
-	for(const auto & refHolder : refHolders) {
+	children_t refHolders;
+	refHolders.swap(children);
+	for(const auto & refHolder : refHolders)
 		refHolder->_setParent(nullptr);
-		refHolder->_updateNeighbors(nullptr, nullptr);
-	}
-
-	firstChild = lastChild = nullptr;
-	contentsCount = 0;
 	//dtor
 }
 
 void Container::_insertAfter(const Ref & child,const Ref & after){
 	if (child.isNull() || child==after) return;
-
-	if(child->getParent()!=this){
-		++contentsCount;
-		if(child->hasParent())
-			child->getParent()->_removeChild(child);
-		child->_setParent(this);
-		child->invalidateAbsPosition();
-	}
-	if(after==getLastChild())
-		lastChild=child;
-	if(firstChild==child)
-		firstChild=child->getNext();
-//    child->insertAfter(after);
-	child->_updateNeighbors(after,after.isNull() ? nullptr : after->getNext());
-	if(firstChild==nullptr)
-		firstChild=child;
-	if(lastChild==nullptr)
-		lastChild=child;
-
-	if(getFirstChild()->getPrev()!=nullptr){
-		firstChild=getFirstChild()->getPrev();
-	}
-	if(getLastChild()->getNext()!=nullptr){
-		lastChild=getLastChild()->getNext();
-	}
-
-	childRectChanged(child.get());
-	invalidateLayout();
+	if(after.isNull())
+		_insertAt(child,0);
+	else if(after->getParent()==this)
+		_insertAt(child,after->_getIndexInParent()+1);
+	else
+		_insertAt(child,children.size());
 }
 
 void Container::_insertBefore(const Ref & child,const Ref & before){
 	if (child.isNull() || child==before) return;
+	if(before.isNotNull() && before->getParent()==this)
+		_insertAt(child,before->_getIndexInParent());
+	else
+		_insertAt(child,children.size());
+}
 
-	if(child->getParent()!=this){
-		++contentsCount;
-		if(child->hasParent()){
-			child->getParent()->_removeChild(child);
-		}
-		child->_setParent(this);
-		childRectChanged(child.get());
-		child->invalidateAbsPosition();
-	}
-	if(before==getFirstChild())
-		firstChild=child;
-//    child->insertBefore(before);
-	child->_updateNeighbors(before.isNull() ? nullptr : before->getPrev(),before);
-
-	if(firstChild==nullptr)
-		firstChild=child;
-	if(lastChild==nullptr)
-		lastChild=child;
-
-	if(getFirstChild()->getPrev()!=nullptr){
-		firstChild=getFirstChild()->getPrev();
-	}
-	if(getLastChild()->getNext()!=nullptr){
-		lastChild=getLastChild()->getNext();
+void Container::_insertAt(const Ref & child,size_t index){
+	if(child.isNull()) return;
+	const Ref childRef(child); // the given reference may be stored in a child vector that is changed below
+
+	if(childRef->getParent()==this){
+		const size_t oldIndex = childRef->_getIndexInParent();
+		if(index>oldIndex)
+			--index;
+		index = std::min(index,children.size()-1);
+		if(index==oldIndex)
+			return;
+		children.erase(children.begin()+oldIndex);
+		children.insert(children.begin()+index,childRef);
+		updateChildIndices(std::min(index,oldIndex),std::max(index,oldIndex)+1);
+	}else{
+		if(childRef->hasParent())
+			childRef->getParent()->_removeChild(childRef);
+		index = std::min(index,children.size());
+		children.insert(children.begin()+index,childRef);
+		updateChildIndices(index,children.size());
+		childRef->_setParent(this);
+		childRef->invalidateAbsPosition();
 	}
-	childRectChanged(child.get());
+	childRectChanged(childRef.get());
 	invalidateLayout();
 }
 
@@ -113,28 +89,70 @@ void Container::_removeChild(const Ref & child) {
 		}
 		return;
 	}
-	if(child==getFirstChild()){
-		firstChild = child->getNext();
-	}
-	if(child==getLastChild()){
-		lastChild = child->getPrev();
-	}
+	const Ref childRef(child);
+	const size_t index = childRef->_getIndexInParent();
+	children.erase(children.begin()+index);
+	updateChildIndices(index,children.size());
+	childRef->_setParent(nullptr);
 
-	child->_updateNeighbors(nullptr,nullptr);
-	child->_setParent(nullptr);
+	childRectChanged(childRef.get());
+	invalidateLayout();
+}
+
+void Container::_addChildren(const children_t & newChildren){
+	// children of this container are moved to the end
+	_removeChildren(newChildren);
+
+	const size_t firstIndex = children.size();
+	for(const auto & child : newChildren){
+		if(child.isNull() || child->getParent()==this) // the same component may be contained several times
+			continue;
+		if(child->hasParent())
+			child->getParent()->_removeChild(child);
+		child->_setParent(this);
+		child->invalidateAbsPosition();
+		children.push_back(child);
+	}
+	if(children.size()==firstIndex)
+		return;
+	updateChildIndices(firstIndex,children.size());
+	childRectChanged(children.back().get());
+	invalidateLayout();
+}
 
-	--contentsCount;
-	childRectChanged(child.get());
+void Container::_removeChildren(const children_t & oldChildren){
+	size_t firstIndex = children.size();
+	Component * lastRemoved = nullptr;
+	for(const auto & child : oldChildren){
+		if(child.isNull() || child->getParent()!=this)
+			continue;
+		firstIndex = std::min(firstIndex,child->_getIndexInParent());
+		child->_setParent(nullptr);
+		lastRemoved = child.get();
+	}
+	if(lastRemoved==nullptr)
+		return;
+	// the removed components are still referenced by oldChildren
+	children.erase( std::remove_if(children.begin()+firstIndex,children.end(),
+								[this](const Ref & child){	return child->getParent()!=this;	}),
+					children.end());
+	updateChildIndices(firstIndex,children.size());
+	childRectChanged(lastRemoved);
 	invalidateLayout();
 }
 
+//! (internal)
+void Container::updateChildIndices(size_t begin,size_t end){
+	for(size_t i = begin; i<end; ++i)
+		children[i]->_setIndexInParent(i);
+}
+
 //! ---|> Component
 std::string Container::toString()const {
 	std::ostringstream s;
-	size_t i = getContentsCount();
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext()){
-		s<<c->toString();
-		if (--i>0)s<<",";
+	for(size_t i = 0; i<children.size(); ++i){
+		if(i>0)s<<",";
+		s<<children[i]->toString();
 	}
 	s<<"]";
 	return s.str();
@@ -150,8 +168,11 @@ void Container::displayChildren(const Geometry::Rect & region,bool useScissor/*=
 		scissorRect.moveRel(1,1);
 		getGUI().pushScissor(scissorRect);
 	}
-		
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext()){
+
+	size_t begin = 0, end = children.size();
+	getVisibleChildRange(myRegion,begin,end);
+	for(size_t i = begin; i<end; ++i){
+		Component * c = children[i].get();
 		if (c->isEnabled() && myRegion.intersects(c->getAbsRect()))
 			c->display(region);
 	}
@@ -175,8 +196,9 @@ Component::visitorResult_t Container::traverseSubtree(Visitor & v) {
 		case EXIT_TRAVERSAL:
 			return EXIT_TRAVERSAL;
 		case CONTINUE_TRAVERSAL:
-			for(Component * c = getFirstChild();c!=nullptr;c = c->getNext()){
-				if(c->traverseSubtree(v) == EXIT_TRAVERSAL)
+			// use indices, as the visitor may change the children
+			for(size_t i = 0; i<children.size(); ++i){
+				if(children[i]->traverseSubtree(v) == EXIT_TRAVERSAL)
 					return EXIT_TRAVERSAL;
 			}
 		default:
@@ -187,8 +209,8 @@ Component::visitorResult_t Container::traverseSubtree(Visitor & v) {
 
 //! ---|> Component
 Component::visitorResult_t Container::traverseChildren(Visitor & v) {
-	for(Component * c = getFirstChild();c!=nullptr;c = c->getNext()){
-		if( v.visit(*c)==EXIT_TRAVERSAL )
+	for(size_t i = 0; i<children.size(); ++i){
+		if( v.visit(*children[i])==EXIT_TRAVERSAL )
 			return EXIT_TRAVERSAL;
 	}
 	return CONTINUE_TRAVERSAL;
@@ -202,33 +224,106 @@ void Container::bringChildToFront(Component * /*c*/) {
 
 //! ---o
 void Container::clearContents(){
-	for(Component::Ref childRef : getContents()) { // don't use the children directly, but use this virtual function getContents to work with specialized types.
-		removeContent(childRef.get());
-	}
+	// don't use the children directly, but use this virtual function getContents to work with specialized types.
+	const std::vector<Component*> contents = getContents();
+	removeContents(children_t(contents.begin(),contents.end()));
 }
 
-void Container::destroyContents(){
-	for(Component::Ref childRef : getContents()) {  // don't use the children directly, but use this virtual function getContents to work with specialized types.
-		Component::destroy(childRef.get());
-	}
-//		getGUI().markForRemoval(*it);
+void Container::replaceContents(const children_t & components){
+	// the given components are referenced, so removing them (if they are already contained) does not destroy them
+	clearContents();
+	addContents(components);
+}
 
-//	this->clear();
+void Container::destroyContents(){
+	// don't use the children directly, but use this virtual function getContents to work with specialized types.
+	const std::vector<Component*> contents = getContents();
+	Component::destroy(children_t(contents.begin(),contents.end()));
 }
 
 //! ---o
 std::vector<Component*> Container::getContents() {
-	std::vector<Component*> children;
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
-		children.push_back(c);
-	return children;
+	std::vector<Component*> contents;
+	contents.reserve(children.size());
+	for(const auto & child : children)
+		contents.push_back(child.get());
+	return contents;
 }
 
 void Container::childRectChanged(Component * /*c*/){
+	cullingIndexValid = false;
+	childrenExtentValid = false;
 	// if(getFlag(LAYOUT_DEPENDS_ON_CHILDREN)) !!!!!!!!!!!!!!!!!!
 	invalidateLayout();
 	// if is sensible to child changes && internal layout is valid
 	//	 invalidate internal layout, inform parent
 }
 
+const Geometry::Vec2 & Container::getChildrenExtent(){
+	if(!childrenExtentValid){
+		childrenExtentValid = true;
+		float x = 0.0f, y = 0.0f;
+		for(const auto & child : children){
+			const Geometry::Rect rect = child->getRect();
+			x = std::max( x, rect.getMaxX() );
+			y = std::max( y, rect.getMaxY() );
+		}
+		childrenExtent = Geometry::Vec2(x,y);
+	}
+	return childrenExtent;
+}
+
+//! (internal)
+void Container::updateCullingIndex(){
+	cullingIndexValid = true;
+	cullingAxis = CULLING_UNSORTED;
+	cullingBegin.clear();
+	cullingMaxEnd.clear();
+	if(children.size()<MIN_CHILDREN_FOR_CULLING)
+		return;
+
+	bool sortedByY = true, sortedByX = true;
+	for(size_t i = 1; i<children.size() && (sortedByY || sortedByX); ++i){
+		const Geometry::Vec2 prevPos = children[i-1]->getPosition();
+		const Geometry::Vec2 pos = children[i]->getPosition();
+		sortedByY = sortedByY && pos.y()>=prevPos.y();
+		sortedByX = sortedByX && pos.x()>=prevPos.x();
+	}
+	if(sortedByY && sortedByX){
+		// e.g. a horizontal row has equal y coordinates: use the axis along which the children are spread
+		const Geometry::Vec2 spread = children.back()->getPosition()-children.front()->getPosition();
+		if(spread.x()<=0 && spread.y()<=0)
+			return;
+		sortedByY = spread.y()>=spread.x();
+	}else if(!sortedByY && !sortedByX){
+		return;
+	}
+	cullingAxis = sortedByY ? CULLING_BY_Y : CULLING_BY_X;
+	cullingBegin.reserve(children.size());
+	cullingMaxEnd.reserve(children.size());
+	float maxEnd = -std::numeric_limits<float>::max();
+	for(const auto & child : children){
+		const Geometry::Rect & rect = child->getRect();
+		cullingBegin.push_back(cullingAxis==CULLING_BY_Y ? rect.getMinY() : rect.getMinX());
+		maxEnd = std::max(maxEnd,cullingAxis==CULLING_BY_Y ? rect.getMaxY() : rect.getMaxX());
+		cullingMaxEnd.push_back(maxEnd);
+	}
+}
+
+//! (internal)
+void Container::getVisibleChildRange(const Geometry::Rect & absRegion,size_t & begin,size_t & end){
+	begin = 0;
+	end = children.size();
+	if(!cullingIndexValid)
+		updateCullingIndex();
+	if(cullingAxis==CULLING_UNSORTED)
+		return;
+	const Geometry::Vec2 absPos = getAbsPosition();
+	const float visibleBegin = cullingAxis==CULLING_BY_Y ? absRegion.getMinY()-absPos.y() : absRegion.getMinX()-absPos.x();
+	const float visibleEnd = cullingAxis==CULLING_BY_Y ? absRegion.getMaxY()-absPos.y() : absRegion.getMaxX()-absPos.x();
+	// all children before begin end before the visible region; all children from end on start behind it.
+	begin = std::lower_bound(cullingMaxEnd.begin(),cullingMaxEnd.end(),visibleBegin) - cullingMaxEnd.begin();
+	end = std::upper_bound(cullingBegin.begin()+begin,cullingBegin.end(),visibleEnd) - cullingBegin.begin();
+}
+
 }
@@ -12,7 +12,7 @@
 #define CONTAINER_H
 
 #include "Component.h"
-#include <list>
+#include <vector>
 
 namespace GUI {
 /***
@@ -31,18 +31,40 @@ class Container : public Component {
 		virtual ~Container();
 
 	public:
-		void _addChild(const Ref & child)	{	_insertAfter(child,getLastChild());	}
+		typedef std::vector<Ref> children_t;
+
+		void _addChild(const Ref & child)	{	_insertAt(child,children.size());	}
+		//! If @p after is nullptr, the child is inserted as first child.
 		void _insertAfter(const Ref & child,const Ref & after);
+		//! If @p before is nullptr, the child is inserted as last child.
 		void _insertBefore(const Ref & child,const Ref & before);
+		//! Insert (or move) the child at the given position; an index greater than the number of children appends the child.
+		void _insertAt(const Ref & child,size_t index);
 		void _removeChild(const Ref & child);
+		/*! Append the given components (in the given order); children of this container are moved to the end.
+			In contrast to calling _addChild(...) for each component, the container's layout is invalidated only once
+			and the child vector is changed at once.	*/
+		void _addChildren(const children_t & newChildren);
+		//! Remove the given children with a single pass over the child vector; components that are no children are ignored.
+		void _removeChildren(const children_t & oldChildren);
 
-		Component * getFirstChild()const	{	return firstChild.get();	}
-		Component * getLastChild()const 	{	return lastChild.get();	}
+		Component * getFirstChild()const	{	return children.empty() ? nullptr : children.front().get();	}
+		Component * getLastChild()const 	{	return children.empty() ? nullptr : children.back().get();	}
+		//! Returns the child at position @p index or nullptr if the index is out of range.
+		Component * getChild(size_t index)const	{	return index<children.size() ? children[index].get() : nullptr;	}
+		/*! Direct (read only) access to the children in display order.
+			\note In contrast to getContents(), this includes internal children (e.g. scroll bars) and
+				the view is invalidated when the children are changed.	*/
+		const children_t & getChildren()const	{	return children;	}
 
 		/*! This is called by a child @p c whenever its rect is changed, it's added or it's removed.
-			The LAYOUT_VALID flag is cleared.	*/
+			The LAYOUT_VALID flag is cleared and the culling index and the children's extent are invalidated.	*/
 		void childRectChanged(Component * c);
 
+		/*! The maximal right and bottom edge of all children (in local coordinates; at least (0,0)).
+			The value is cached until a child's rect is changed or a child is added or removed (see childRectChanged(...)).	*/
+		const Geometry::Vec2 & getChildrenExtent();
+
 		// ---o
 		virtual void addContent(const Ref & child) 		{	_addChild(child);	}
 		// ---o
@@ -50,13 +72,23 @@ class Container : public Component {
 		// ---o
 		virtual void clearContents();
 
+		/*! ---o
+			Bulk versions of addContent(...) and removeContent(...): the invalidation and the notifications
+			are done once for all components.
+			\note Specialized containers overriding addContent(...) or removeContent(...) have to override these as well.	*/
+		virtual void addContents(const children_t & components)		{	_addChildren(components);	}
+		// ---o
+		virtual void removeContents(const children_t & components)	{	_removeChildren(components);	}
+		//! Replace all contents (see getContents()) by the given components.
+		void replaceContents(const children_t & components);
+
 		/*! Remove all children and mark them for removal .
 			The childrens' subtrees will be dissolved and their attributes will be removed.
 			\note this does (or should not) not remove the internal children like scroll bars.*/
 		void destroyContents();
 
 		// ---o
-		virtual size_t getContentsCount()const 			{	return contentsCount;	}
+		virtual size_t getContentsCount()const 			{	return children.size();	}
 		// ---o
 		virtual void bringChildToFront(Component * c);
 		// ---o
@@ -82,9 +114,36 @@ class Container : public Component {
 		void displayChildren(const Geometry::Rect & region,bool useScissor=false);
 		void copyChildrenTo(Container & target)const;
 
-		Ref firstChild;
-		Ref lastChild;
-		size_t contentsCount;
+	private:
+		children_t children;
+		Geometry::Vec2 childrenExtent;
+		bool childrenExtentValid;
+
+		//! (internal) Update the stored positions of the children in [begin,end).
+		void updateChildIndices(size_t begin,size_t end);
+
+	/*!	@name Display culling
+		If a container has many children that are ordered by their y (or x) coordinate (e.g. a vertical (horizontal)
+		stack created by a FlowLayouter), displayChildren(...) determines the children overlapping the displayed region
+		by binary search instead of testing all children. If the children are ordered along both axes, the axis along
+		which they are spread further is used. The index is rebuilt lazily after a child has been changed.	*/
+	// @{
+	public:
+		//! Minimal number of children for using the culling index.
+		static const size_t MIN_CHILDREN_FOR_CULLING = 32;
+	private:
+		enum cullingAxis_t{	CULLING_UNSORTED, CULLING_BY_X, CULLING_BY_Y	};
+		cullingAxis_t cullingAxis;
+		bool cullingIndexValid;
+		std::vector<float> cullingBegin;	//!< the children's (non decreasing) start coordinate along the culling axis
+		std::vector<float> cullingMaxEnd;	//!< cullingMaxEnd[i] is the maximal end coordinate of the children 0...i
+
+		void updateCullingIndex();
+		//! Determine the range [begin,end) of children that may overlap the given absolute region.
+		void getVisibleChildRange(const Geometry::Rect & absRegion,size_t & begin,size_t & end);
+	// @}
 };
+
+template<> struct ComponentTypeTag<Container>{	static const Component::typeTag_t value = Component::TYPE_CONTAINER;	};
 }
 #endif // CONTAINER_H
@@ -37,6 +37,11 @@ class EditorPanel: public Container {
 			unmarkChild(child.get());
 			Container::removeContent(child);
 		}
+		virtual void removeContents(const children_t & components) override	{
+			for(const auto & child : components)
+				unmarkChild(child.get());
+			Container::removeContents(components);
+		}
 		virtual void clearContents() override 	{
 			unmarkAll();
 			Container::clearContents();
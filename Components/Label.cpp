@@ -11,6 +11,7 @@
 #include "Label.h"
 #include "../GUI_Manager.h"
 #include "../Base/Draw.h"
+#include "../Base/Fonts/TextLayout.h"
 #include "../Base/Properties.h"
 #include "ComponentPropertyIds.h"
 #include <sstream>
@@ -44,7 +45,29 @@ Label::~Label(){
 void Label::doDisplay(const Geometry::Rect & /*region*/){
 	enableLocalDisplayProperties();
 	displayDefaultShapes();	
-	Draw::drawText(getText(),getLocalRect(),getGUI().getActiveFont(PROPERTY_DEFAULT_FONT),getGUI().getActiveColor( PROPERTY_TEXT_COLOR ),textStyle);
+	AbstractFont * font = getGUI().getActiveFont(PROPERTY_DEFAULT_FONT);
+	if(getFlag(WRAP_TEXT) && font!=nullptr){
+		updateTextLayout(font);
+		const Geometry::Rect rect = getLocalRect();
+		const Util::Color4ub color = getGUI().getActiveColor( PROPERTY_TEXT_COLOR );
+		const float lineHeight = font->getLineHeight();
+		Geometry::Vec2 pos = rect.getPosition();
+		if(textStyle&Draw::TEXT_ALIGN_MIDDLE)
+			pos.y( pos.y() + (rect.getHeight()-textLayout->getNumberOfRows()*lineHeight)*0.5 );
+		for(size_t p = 0; p<paragraphs.size(); ++p){
+			for(const auto & line : textLayout->getLines(p)){
+				pos.x( rect.getMinX() );
+				if(textStyle&Draw::TEXT_ALIGN_RIGHT)
+					pos.x( pos.x() + rect.getWidth()-line.width );
+				else if(textStyle&Draw::TEXT_ALIGN_CENTER)
+					pos.x( pos.x() + (rect.getWidth()-line.width)*0.5 );
+				Draw::drawText(paragraphs[p].substr(line.begin,line.end-line.begin),pos,font,color);
+				pos.y( pos.y() + lineHeight );
+			}
+		}
+	}else{
+		Draw::drawText(getText(),getLocalRect(),font,getGUI().getActiveColor( PROPERTY_TEXT_COLOR ),textStyle);
+	}
 	if(getGUI().getDebugMode()>0)
 		Draw::drawLineRect(getLocalRect(),Util::Color4ub(255,0,0,20));
 	disableLocalDisplayProperties();
@@ -52,8 +75,15 @@ void Label::doDisplay(const Geometry::Rect & /*region*/){
 
 //! ---|> Component
 void Label::doLayout(){
-	if(getFlag(RECALCULATE_SIZE)){
-		const Geometry::Vec2 newSize = Draw::getTextSize(getText(),getGUI().getActiveFont(PROPERTY_DEFAULT_FONT));
+	AbstractFont * font = getGUI().getActiveFont(PROPERTY_DEFAULT_FONT);
+	if(getFlag(WRAP_TEXT) && font!=nullptr){
+		// the width is given; the height follows from the number of lines
+		updateTextLayout(font);
+		if(!hasLayouter())
+			setHeight( textLayout->getNumberOfRows()*font->getLineHeight() );
+		setFlag(RECALCULATE_SIZE,false);
+	}else if(getFlag(RECALCULATE_SIZE)){
+		const Geometry::Vec2 newSize = Draw::getTextSize(getText(),font);
 		setSize( textStyle==Draw::TEXT_ALIGN_LEFT ? newSize.x() : getWidth(), newSize.y() );
 		setFlag(RECALCULATE_SIZE,false);
 	}
@@ -67,10 +97,35 @@ void Label::setText(const std::string & newText){
 		invalidateLayout();
 		setFlag(RECALCULATE_SIZE,true);
 	}
+	if(textLayout && text!=newText){ // only the changed paragraphs have to be broken again
+		std::vector<std::string> newParagraphs = TextLayout::splitParagraphs(newText);
+		if(newParagraphs.size()==paragraphs.size()){
+			for(size_t i = 0; i<paragraphs.size(); ++i){
+				if(paragraphs[i]!=newParagraphs[i])
+					textLayout->invalidateParagraphs(i,i);
+			}
+		}else{
+			textLayout->reset(newParagraphs.size());
+		}
+		paragraphs.swap(newParagraphs);
+	}
 	text = newText;
 
 }
 
+//! (internal)
+void Label::updateTextLayout(AbstractFont * font){
+	if(!textLayout){
+		textLayout.reset(new TextLayout);
+		paragraphs = TextLayout::splitParagraphs(text);
+		textLayout->reset(paragraphs.size());
+	}
+	textLayout->setFont(font);
+	textLayout->setMaxWidth(getWidth());
+	if(textLayout->needsUpdate())
+		textLayout->update([this](size_t i) -> const std::string & {	return paragraphs[i];	});
+}
+
 void Label::setColor(const Util::Color4ub & newColor){
 	addProperty(new ColorProperty(PROPERTY_TEXT_COLOR,newColor));
 }
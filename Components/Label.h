@@ -13,9 +13,13 @@
 
 #include "Component.h"
 #include "../Base/Fonts/AbstractFont.h"
+#include <memory>
+#include <vector>
 
 namespace GUI{
 
+class TextLayout;
+
 /***
  **  Label ---|> Component
  **/
@@ -25,6 +29,8 @@ class Label: public Component	{
 		static const flag_t RECALCULATE_SIZE=1<<24;
 	
 	public:
+		static const flag_t WRAP_TEXT=1<<25; //!< Break the text into lines fitting into the label's width; without a layouter, the height is adjusted to the text.
+
 		Label(GUI_Manager & gui,const std::string &text="",flag_t flags=0);
 		Label(GUI_Manager & gui,const Geometry::Rect & r,const std::string &text="",flag_t flags=0);
 		virtual ~Label();
@@ -45,6 +51,11 @@ class Label: public Component	{
 		std::string text;
 		unsigned int textStyle;
 
+		//! Line breaks of the paragraphs of the text; only created if the WRAP_TEXT flag is used.
+		std::unique_ptr<TextLayout> textLayout;
+		std::vector<std::string> paragraphs;
+		void updateTextLayout(AbstractFont * font);
+
 };
 
 }
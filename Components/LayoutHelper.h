@@ -18,7 +18,7 @@ namespace GUI {
 class NextRow: public Component	{
 		PROVIDES_TYPE_NAME(NextRow)
 	public:
-		NextRow(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {}
+		NextRow(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {	addTypeTag(TYPE_NEXT_ROW);	}
 		NextRow(const NextRow & c) : Component(c),additionalSpacing(c.additionalSpacing) {}
 		virtual ~NextRow(){}
 
@@ -30,7 +30,7 @@ class NextRow: public Component	{
 class NextColumn: public Component	{
 		PROVIDES_TYPE_NAME(NextColumn)
 	public:
-		NextColumn(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {}
+		NextColumn(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {	addTypeTag(TYPE_NEXT_COLUMN);	}
 
 		NextColumn(const NextColumn & c) : Component(c),additionalSpacing(c.additionalSpacing) {}
 		virtual ~NextColumn() {}
@@ -40,5 +40,8 @@ class NextColumn: public Component	{
 		float additionalSpacing;
 };
 
+template<> struct ComponentTypeTag<NextRow>{	static const Component::typeTag_t value = Component::TYPE_NEXT_ROW;	};
+template<> struct ComponentTypeTag<NextColumn>{	static const Component::typeTag_t value = Component::TYPE_NEXT_COLUMN;	};
+
 }
 #endif // GUI_LayoutHelper_H
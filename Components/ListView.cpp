@@ -181,11 +181,28 @@ void ListView::doDisplay(const Geometry::Rect & region) {
 
 //! ---|> Container
 void ListView::addContent(const Ref & child)		{
-	clientArea->addContent(child);
-	entryRegistry.push_back(child.get());
-	resetPositions(static_cast<int>(getContentsCount()) - 1);
-	if(markingList.empty() && getFlag(AT_LEAST_ONE_MARKING)) {
-		addMarking(child.get());
+	addContents(children_t(1,child));
+}
+
+//! ---|> Container
+void ListView::addContents(const children_t & components) {
+	bool onlyNewEntries = true;
+	for(const auto & child : components) {
+		if(child.isNotNull() && child->getParent() == clientArea.get())
+			onlyNewEntries = false;
+	}
+	const size_t firstNewIndex = entryRegistry.size();
+	clientArea->addContents(components);
+	if(onlyNewEntries) {
+		for(size_t i = firstNewIndex; i < clientArea->getChildren().size(); ++i)
+			entryRegistry.push_back(clientArea->getChild(i));
+		resetPositions(firstNewIndex);
+	} else { // existing entries have been moved to the end
+		rebuildRegistry();
+		resetPositions(0);
+	}
+	if(markingList.empty() && getFlag(AT_LEAST_ONE_MARKING) && firstNewIndex < entryRegistry.size()) {
+		addMarking(entryRegistry[firstNewIndex]);
 	}
 	invalidateLayout();
 }
@@ -205,14 +222,26 @@ size_t ListView::getEntryIndexByPosition(const Geometry::Vec2 & p)const {
 
 //! ---|> Container
 void ListView::removeContent(const Ref & child)	{
-	assertIsChild(child.get());
-	clientArea->removeContent(child);
+	removeContents(children_t(1,child));
+}
+
+//! ---|> Container
+void ListView::removeContents(const children_t & components) {
+	for(const auto & child : components)
+		assertIsChild(child.get());
+	// the markings have to be removed while the components are still children
+	bool markingsChanged = false;
+	for(const auto & child : components)
+		markingsChanged |= doRemoveMarking(child.get(), true);
+	clientArea->removeContents(components);
 	rebuildRegistry();
 	resetPositions(0);
-	removeMarking(child.get(), true);
 	if(getFlag(AT_LEAST_ONE_MARKING) && markingList.empty() && !entryRegistry.empty()) {
-		addMarking(entryRegistry.front());
+		doAddMarking(entryRegistry.front());
+		markingsChanged = true;
 	}
+	if(markingsChanged)
+		markingChanged();
 	invalidateLayout();
 }
 //! ---|> Container
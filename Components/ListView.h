@@ -102,6 +102,10 @@ public:
 		virtual size_t getContentsCount()const override						{   return clientArea->getContentsCount();	}
 		// ---|> Container
 		virtual void removeContent(const Ref & child) override;
+		// ---|> Container
+		virtual void addContents(const children_t & components) override;
+		// ---|> Container
+		virtual void removeContents(const children_t & components) override;
 
 
 	private:
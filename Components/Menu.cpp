@@ -21,6 +21,7 @@ Menu::Menu(GUI_Manager & _gui, flag_t _flags) :
 	Container(_gui, _flags),
 	keyListener(createKeyListener(_gui, this, &Menu::onKeyEvent)),
 	mouseButtonListener(createMouseButtonListener(_gui, this, &Menu::onMouseButton)) {
+	addTypeTag(TYPE_MENU);
 	disable();
 	setFlag(ALWAYS_ON_TOP,true);
 	addProperty(new UseColorProperty(PROPERTY_TEXT_COLOR,PROPERTY_MENU_TEXT_COLOR));
@@ -71,7 +72,7 @@ static void onFrame(Menu & menu, double /*timeSecs*/) {
 				continue;
 			}
 			// something other than a menu in front of this menu? -> close this
-			if(dynamic_cast<Menu*>(c) == nullptr) {
+			if(component_cast<Menu>(c) == nullptr) {
 				menu.close();
 				return;
 			}
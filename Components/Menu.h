@@ -50,5 +50,7 @@ class Menu: public Container {
 		virtual void open(const Geometry::Vec2 &pos);
 		virtual void close();
 };
+
+template<> struct ComponentTypeTag<Menu>{	static const Component::typeTag_t value = Component::TYPE_MENU;	};
 }
 #endif // GUI_MENU_H
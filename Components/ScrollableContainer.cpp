@@ -29,6 +29,7 @@ ScrollableContainer::ScrollableContainer(GUI_Manager & _gui,flag_t _flags/*=0*/)
 		contentContainer(new Container(_gui)),
 		mouseButtonListener(createMouseButtonListener(_gui, this, &ScrollableContainer::onMouseButton)),
 		optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &ScrollableContainer::onMouseMove)) {
+	addTypeTag(TYPE_SCROLLABLE_CONTAINER);
 	_addChild(contentContainer.get());
 	contentContainer->setFlag(IS_CLIENT_AREA,true);
 	setFlag(USE_SCISSOR,true);
@@ -40,6 +40,8 @@ class ScrollableContainer: public Container {
 		virtual void clearContents() override									{	contentContainer->clearContents();	}
 		virtual std::vector<Component*> getContents() override 					{	return contentContainer->getContents();		}
 		virtual void removeContent(const Ref & child) override					{	contentContainer->removeContent(child);	}
+		virtual void addContents(const children_t & components) override		{	contentContainer->addContents(components);	}
+		virtual void removeContents(const children_t & components) override	{	contentContainer->removeContents(components);	}
 		virtual void insertAfter(const Ref & child,const Ref & after) override	{	contentContainer->insertAfter(child,after);	}
 		virtual void insertBefore(const Ref & child,const Ref & after) override	{	contentContainer->insertBefore(child,after);	}
 		virtual size_t getContentsCount()const override							{   return contentContainer->getContentsCount();	}
@@ -60,5 +62,7 @@ class ScrollableContainer: public Container {
 		bool onMouseButton(Component * component, const Util::UI::ButtonEvent & buttonEvent);
 		bool onMouseMove(Component * component, const Util::UI::MotionEvent & motionEvent);
 };
+
+template<> struct ComponentTypeTag<ScrollableContainer>{	static const Component::typeTag_t value = Component::TYPE_SCROLLABLE_CONTAINER;	};
 }
 #endif // GUI_ScrollableContainer_H
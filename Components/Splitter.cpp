@@ -61,19 +61,21 @@ class StackingLayouter : public AbstractLayouter{
 		
 		//! ---|> AbstractLayouter
 		void layout(Util::WeakPointer<Component> component) override{
-			Container * container = dynamic_cast<Container*>(component.get());
+			Container * container = component_cast<Container>(component.get());
 			if(!container){
 				throw std::invalid_argument("FlowLayouter can only be applied to Containers.");
 			}
 			if(vertical){
 				int x = 0;
-				for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+				for(const auto & cRef : container->getChildren()){
+					Component * c = cRef.get();
 					c->setPosition( Geometry::Vec2(x,0));
 					x+=c->getWidth();
 				}
 			}else{
 				int y = 0;
-				for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+				for(const auto & cRef : container->getChildren()){
+					Component * c = cRef.get();
 					c->setPosition( Geometry::Vec2(0,y));
 					y+=c->getHeight();
 				}
@@ -61,9 +61,9 @@ struct TabTitlePanel : public Container {
 		}else if(keyEvent.key==Util::UI::KEY_LEFT) {
 			TabbedPanel::Tab * t=getTab();
 			if (t->getPrev())
-				t=dynamic_cast<TabbedPanel::Tab *>(t->getPrev());
+				t=component_cast<TabbedPanel::Tab>(t->getPrev());
 			else
-				t=dynamic_cast<TabbedPanel::Tab *>(getTab()->getTabbedPanel()->getLastChild());
+				t=component_cast<TabbedPanel::Tab>(getTab()->getTabbedPanel()->getLastChild());
 			if(t){
 //			    t->makeActiveTab();
 				t->getTitlePanel()->select();
@@ -72,9 +72,9 @@ struct TabTitlePanel : public Container {
 		}else if(keyEvent.key==Util::UI::KEY_RIGHT) {
 			TabbedPanel::Tab * t=getTab();
 			if (t->getNext())
-				t=dynamic_cast<TabbedPanel::Tab *>(t->getNext());
+				t=component_cast<TabbedPanel::Tab>(t->getNext());
 			else
-				t=dynamic_cast<TabbedPanel::Tab *>(getTab()->getTabbedPanel()->getFirstChild());
+				t=component_cast<TabbedPanel::Tab>(getTab()->getTabbedPanel()->getFirstChild());
 			if(t){
 //			    t->makeActiveTab();
 				t->getTitlePanel()->select();
@@ -141,7 +141,7 @@ struct TabTitlePanel : public Container {
 			return true;
 		}
 
-		TabbedPanel * tp=dynamic_cast<TabbedPanel *>(getGUI().getComponentAtPos(absPos));
+		TabbedPanel * tp=component_cast<TabbedPanel>(getGUI().getComponentAtPos(absPos));
 		if (tp==nullptr)
 			return true;
 //                    tp->insertTab(&myTab,0);
@@ -187,6 +187,7 @@ struct TabTitlePanel : public Container {
 //! (Tab] [ctor)
 TabbedPanel::Tab::Tab(GUI_Manager & _gui,const std::string & _title,Container * _clientArea/*=0*/)
 		:Container(_gui),clientAreaPanel(_clientArea),titlePanel(nullptr),titleTextLabel(nullptr) {
+	addTypeTag(TYPE_TAB);
 	setFlag(TRANSPARENT_COMPONENT,true);
 
 	setFlag(AUTO_MAXIMIZE,true);
@@ -271,7 +272,7 @@ bool TabbedPanel::Tab::isActiveTab()const {
 
 //! (Tab)
 TabbedPanel * TabbedPanel::Tab::getTabbedPanel()const {
-	return dynamic_cast<TabbedPanel * >(getParent());
+	return component_cast<TabbedPanel>(getParent());
 }
 
 //! (Tab)
@@ -290,7 +291,7 @@ void TabbedPanel::Tab::makeActiveTab() {
 //! (ctor)
 TabbedPanel::TabbedPanel(GUI_Manager & _gui,flag_t _flags/*=0*/) : 
 		Container(_gui,_flags),activeTab(nullptr) {
-	//ctor
+	addTypeTag(TYPE_TABBED_PANEL);
 }
 
 
@@ -325,7 +326,7 @@ void TabbedPanel::setActiveTab(Tab * tab) {
 
 //! ----|> Component
 void TabbedPanel::bringChildToFront(Component * c) {
-	Tab * t=dynamic_cast<Tab *>(c);
+	Tab * t=component_cast<Tab>(c);
 	if (c)
 		setActiveTab(t);
 	bringToFront();
@@ -334,7 +335,7 @@ void TabbedPanel::bringChildToFront(Component * c) {
 void TabbedPanel::recalculateTabTitlePositions() {
 	float pos=5;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		Tab * t=dynamic_cast<Tab*>(c);
+		Tab * t=component_cast<Tab>(c);
 		if (t!=nullptr) {
 			t->setTabTitlePos(pos);
 			pos+=t->getTabTitleWidth()+1;
@@ -347,7 +348,7 @@ void TabbedPanel::recalculateTabTitlePositions() {
 //! ----|> Component
 void TabbedPanel::doLayout() {
 	if ( activeTab==nullptr || activeTab->getParent()!=this ) {
-		setActiveTab(dynamic_cast<Tab*>(getLastChild()));
+		setActiveTab(component_cast<Tab>(getLastChild()));
 	}
 	
 }
@@ -364,10 +365,22 @@ void TabbedPanel::removeContent(const Ref & child) {
 	recalculateTabTitlePositions();
 }
 
+//! ---|> Container
+void TabbedPanel::addContents(const children_t & components) {
+	_addChildren(components);
+	recalculateTabTitlePositions();
+}
+
+//! ---|> Container
+void TabbedPanel::removeContents(const children_t & components) {
+	Container::removeContents(components);
+	recalculateTabTitlePositions();
+}
+
 void TabbedPanel::setActiveTabIndex(int nr){
 	int currentIndex=0;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		Tab * t=dynamic_cast<Tab*>(c);
+		Tab * t=component_cast<Tab>(c);
 		if (t!=nullptr) {
 			if(currentIndex == nr){
 				setActiveTab(t);
@@ -381,7 +394,7 @@ void TabbedPanel::setActiveTabIndex(int nr){
 int TabbedPanel::getActiveTabIndex()const{
 	int currentIndex=0;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		const Tab * t=dynamic_cast<const Tab*>(c);
+		const Tab * t=component_cast<Tab>(c);
 		if (t!=nullptr) {
 			if( t==activeTab ){
 				return currentIndex;
@@ -52,6 +52,8 @@ class TabbedPanel : public Container {
 				// ---|> Container
 				virtual void addContent(const Ref & child) override		{	clientAreaPanel->addContent(child);	}
 				virtual void removeContent(const Ref & child) override	{	clientAreaPanel->removeContent(child);	}
+				virtual void addContents(const children_t & components) override		{	clientAreaPanel->addContents(components);	}
+				virtual void removeContents(const children_t & components) override	{	clientAreaPanel->removeContents(components);	}
 				virtual size_t getContentsCount()const override			{	return clientAreaPanel->getContentsCount();	}
 
 				// ---|> Component
@@ -89,6 +91,8 @@ class TabbedPanel : public Container {
 		// ---|> Container
 		virtual void addContent(const Ref & child) override;
 		virtual void removeContent(const Ref & child) override;
+		virtual void addContents(const children_t & components) override;
+		virtual void removeContents(const children_t & components) override;
 		virtual void bringChildToFront(Component * c) override;
 
 		// ---|> Component
@@ -96,5 +100,8 @@ class TabbedPanel : public Container {
 	private:
 		Tab * activeTab;
 };
+
+template<> struct ComponentTypeTag<TabbedPanel>{	static const Component::typeTag_t value = Component::TYPE_TABBED_PANEL;	};
+template<> struct ComponentTypeTag<TabbedPanel::Tab>{	static const Component::typeTag_t value = Component::TYPE_TAB;	};
 }
 #endif // GUI_TAB_H
@@ -12,6 +12,7 @@
 #include "../GUI_Manager.h"
 #include "../Base/Layouters/ExtLayouter.h"
 #include "../Base/Draw.h"
+#include "../Base/Fonts/TextLayout.h"
 #include "../Base/ListenerHelper.h"
 #include "ComponentPropertyIds.h"
 #include "Scrollbar.h"
@@ -28,7 +29,6 @@
 - interface for search and replace
 - invalid line range
 - fixed size font support
-- auto line break
 - syntax highlighting / parser support
 - row marker
 - tabs-support
@@ -89,7 +89,7 @@ public:
 				const Geometry::Vec2 p1 = cursorToTextPos(ta,c1)-scrollPos;
 				const Geometry::Vec2 p2 = cursorToTextPos(ta,c2)-scrollPos;
 
-				if(c1.first == c2.first){ // same line
+				if(p1.y() == p2.y()){ // same row
 					gui.displayShape(PROPERTY_TEXTFIELD_TEXT_SELECTION_SHAPE,
 											Geometry::Rect(p1.x(),p1.y(),p2.x()-p1.x(),lineHeight));
 				}else{
@@ -97,7 +97,7 @@ public:
 											Geometry::Rect(p1.x(),p1.y(),localRect.getWidth()-p1.x(),lineHeight));
 					gui.displayShape(PROPERTY_TEXTFIELD_TEXT_SELECTION_SHAPE,
 											Geometry::Rect(0,p2.y(),p2.x(),lineHeight));
-					if(c2.first-c1.first>1){
+					if(p2.y()-p1.y()>lineHeight){
 						gui.displayShape(PROPERTY_TEXTFIELD_TEXT_SELECTION_SHAPE,
 												Geometry::Rect(0,p1.y()+lineHeight,ta.getWidth(),p2.y()-p1.y()-lineHeight));
 					}
@@ -114,15 +114,9 @@ public:
 			gui.displayShape(PROPERTY_SELECTION_RECT_SHAPE,rect);
 
 		}
-		const size_t firstLine = static_cast<size_t>(scrollPos.y() / lineHeight);
-		const size_t endLine = std::min( firstLine+static_cast<size_t>(localRect.getHeight() / lineHeight)+1,ta.getNumberOfLines());
-
-		//auto & data = getData(ta);
-		for(size_t l = firstLine; l<endLine; ++l ){
-			Draw::drawText(ta.getLine(l),cursorToTextPos(ta,std::make_pair(l,0))-scrollPos,
-					ta._getActiveFont(),gui.getActiveColor(PROPERTY_TEXTFIELD_TEXT_COLOR));
-//					ta._getActiveFont(),data.lineMarker[l]);
-		}
+		const size_t firstRow = static_cast<size_t>(scrollPos.y() / lineHeight);
+		const size_t endRow = std::min( firstRow+static_cast<size_t>(localRect.getHeight() / lineHeight)+1,getNumberOfRows(ta));
+		displayRows(ta,firstRow,endRow);
 
 		if(scrollPos.x()>0)
 			gui.displayShape(PROPERTY_SCROLLABLE_MARKER_LEFT_SHAPE, localRect, 0);
@@ -132,6 +126,18 @@ public:
 			gui.displayShape(PROPERTY_SCROLLABLE_MARKER_BOTTOM_SHAPE, localRect, 0);
 
 	}
+	//! Draw the visible rows [firstRow,endRow); without line wrapping, each line is one row.
+	virtual void displayRows(Textarea& ta,size_t firstRow,size_t endRow){
+		//auto & data = getData(ta);
+		for(size_t l = firstRow; l<endRow; ++l ){
+			Draw::drawText(ta.getLine(l),cursorToTextPos(ta,std::make_pair(l,0))-ta.getScrollPos(),
+					ta._getActiveFont(),ta.getGUI().getActiveColor(PROPERTY_TEXTFIELD_TEXT_COLOR));
+//					ta._getActiveFont(),data.lineMarker[l]);
+		}
+	}
+	virtual size_t getNumberOfRows(const Textarea& ta){
+		return ta.getNumberOfLines();
+	}
 	void consolidateLines(Textarea&/*ta*/,const std::pair<size_t,size_t>&/*lines*/) override{
 		/*auto & data = getData(ta);
 		for(size_t l=lines.first;l<=lines.second && l<data.lineMarker.size();++l)
@@ -174,6 +180,90 @@ public:
 		data.lineMarker.erase( std::next(data.lineMarker.begin(),first),std::next(data.lineMarker.begin(),first+number)); */
 //		std::cout << "Lines erased: "<<first<<" -"<<number<<"\n";
 	}
+	void onLinesChanged(Textarea& /*ta*/,size_t /*first*/,size_t /*last*/) override{
+	}
+};
+
+// -----------------------------------------------------------------
+//! (internal) Soft wrapping of long lines at the width of the textarea.
+class WrappingTextProcessor : public SimpleTextProcessor{
+	mutable TextLayout layout; // updated lazily, also by the const queries
+
+	void updateLayout(const Textarea& ta)const{
+		layout.setFont(ta._getActiveFont());
+		layout.setMaxWidth(std::max(1.0f,ta.getWidth()-ta.getGUI().getGlobalValue(PROPERTY_SCROLLBAR_WIDTH)-10));
+		if(layout.getNumberOfParagraphs()!=ta.getNumberOfLines())
+			layout.reset(ta.getNumberOfLines());
+		if(layout.needsUpdate())
+			layout.update([&ta](size_t i) -> const std::string & {	return ta.getLine(i);	});
+	}
+public:
+	explicit WrappingTextProcessor(const Textarea& ta){
+		layout.reset(ta.getNumberOfLines());
+	}
+	virtual ~WrappingTextProcessor(){}
+
+	void displayRows(Textarea& ta,size_t firstRow,size_t endRow) override{
+		updateLayout(ta);
+		const Util::Color4ub color = ta.getGUI().getActiveColor(PROPERTY_TEXTFIELD_TEXT_COLOR);
+		for(size_t row = firstRow; row<endRow; ++row){
+			const auto lineNr = layout.getParagraphAtRow(row);
+			const auto & line = layout.getLines(lineNr.first).at(lineNr.second);
+			Draw::drawText(ta.getLine(lineNr.first).substr(line.begin,line.end-line.begin),
+					Geometry::Vec2(0,row*ta._getLineHeight())-ta.getScrollPos(),ta._getActiveFont(),color);
+		}
+	}
+	size_t getNumberOfRows(const Textarea& ta) override{
+		updateLayout(ta);
+		return layout.getNumberOfRows();
+	}
+	Geometry::Vec2 cursorToTextPos(const Textarea& ta,const Textarea::cursor_t &c) override{
+		if(ta.getNumberOfLines()==0){
+			return Geometry::Vec2(0,0);
+		}
+		updateLayout(ta);
+		if(c.first>=ta.getNumberOfLines())
+			return Geometry::Vec2(0,layout.getNumberOfRows()*ta._getLineHeight());
+		const auto & text = ta.getLine(c.first);
+		const size_t pos = std::min(c.second,text.length());
+		const size_t lineIndex = layout.getLineIndex(c.first,pos);
+		const auto & line = layout.getLines(c.first)[lineIndex];
+		const float x = pos>line.begin ?
+					Draw::getTextSize(text.substr(line.begin,pos-line.begin),ta._getActiveFont()).width() : 0;
+		return Geometry::Vec2(x,(layout.getFirstRow(c.first)+lineIndex)*ta._getLineHeight());
+	}
+	Textarea::cursor_t textPosToCursor(const Textarea& ta,const Geometry::Vec2 &textPos)const override{
+		if(ta.getNumberOfLines()==0||textPos.y()<0){
+			return std::make_pair(0,0);
+		}
+		updateLayout(ta);
+		const size_t row = std::min( static_cast<size_t>(textPos.y() / ta._getLineHeight()), layout.getNumberOfRows()-1);
+		const auto lineNr = layout.getParagraphAtRow(row);
+		const auto & lines = layout.getLines(lineNr.first);
+		const std::string & text = ta.getLine(lineNr.first);
+		const bool lastLine = lineNr.second+1==lines.size();
+		const size_t begin = lines[lineNr.second].begin;
+		const size_t end = lastLine ? text.length() : lines[lineNr.second+1].begin;
+
+		int cursor = begin;
+		while( cursor<static_cast<int>(end) ){
+			const int next = getNextCursorPos(text,cursor);
+			if( Draw::getTextSize(text.substr(begin,next-begin),ta._getActiveFont()).x() >= textPos.x())
+				return std::make_pair(lineNr.first,cursor);
+			cursor = next;
+		}
+		// behind the end of a wrapped line: stay in front of the whitespace at the soft break
+		return std::make_pair(lineNr.first,lastLine ? text.length() : lines[lineNr.second].end);
+	}
+	void onLinesInserted(Textarea& /*ta*/,size_t first,size_t number) override{
+		layout.insertParagraphs(first,number);
+	}
+	void onLineErased(Textarea& /*ta*/,size_t first,size_t number) override{
+		layout.eraseParagraphs(first+1,number); // the lines behind 'first' are removed
+	}
+	void onLinesChanged(Textarea& /*ta*/,size_t first,size_t last) override{
+		layout.invalidateParagraphs(first,last);
+	}
 };
 
 // -----------------------------------------------------------------
@@ -182,6 +272,7 @@ public:
 Textarea::Textarea(GUI_Manager & _gui, flag_t _flags):
 		Container(_gui, _flags),
 		lineHeight(15),
+		softWrap(false),
 		selectionStart(std::make_pair(0, std::string::npos)),
 		dataChanged(false),
 		activeTextUpdateIndex(0),
@@ -196,6 +287,19 @@ Textarea::Textarea(GUI_Manager & _gui, flag_t _flags):
     processor = new SimpleTextProcessor;
 }
 
+void Textarea::setSoftWrap(bool b){
+	if(b==softWrap)
+		return;
+	softWrap = b;
+	if(softWrap)
+		processor = new WrappingTextProcessor(*this);
+	else
+		processor = new SimpleTextProcessor;
+	scrollTo(Geometry::Vec2(0,getScrollPos().y()));
+	invalidateRegion();
+	updateScrollPos();
+}
+
 //! (dtor)
 Textarea::~Textarea() {
 	if(optionalScrollBarListener) {
@@ -339,6 +443,7 @@ Textarea::cursor_t Textarea::_deleteText(const range_t & r){
 			processor->onLineErased(*this,pBegin.first,pEnd.first-pBegin.first);
 		}
 		markForConsolidation(pBegin.first,pBegin.first);
+		processor->onLinesChanged(*this,pBegin.first,pBegin.first);
 		dataChanged = true;
 	}
 	return pBegin;
@@ -407,6 +512,7 @@ Textarea::range_t Textarea::_insertText(const cursor_t & pos,const std::string &
 		}
 	}
 	markForConsolidation(pos.first,endPos.first);
+	processor->onLinesChanged(*this,pos.first,endPos.first);
 	return range(pos,endPos);
 }
 
@@ -443,6 +549,13 @@ bool Textarea::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 		}else if(cursor.first>0){
 			moveCursor(std::make_pair(cursor.first-1,getLine(cursor.first-1).length()),shiftPressed);
 		}
+	} else if(keyEvent.key == Util::UI::KEY_UP && softWrap) { // move to the previous row
+		const Geometry::Vec2 pos = processor->cursorToTextPos(*this,cursor);
+		if(pos.y()>0)
+			moveCursor(processor->textPosToCursor(*this,pos-Geometry::Vec2(0,lineHeight*0.5f)),shiftPressed);
+	} else if(keyEvent.key == Util::UI::KEY_DOWN && softWrap) { // move to the next row
+		const Geometry::Vec2 pos = processor->cursorToTextPos(*this,cursor);
+		moveCursor(processor->textPosToCursor(*this,pos+Geometry::Vec2(0,lineHeight*1.5f)),shiftPressed);
 	} else if(keyEvent.key == Util::UI::KEY_UP) {
 		if(cursor.first>0){
 			moveCursor(std::make_pair(cursor.first-1,cursor.second),shiftPressed);
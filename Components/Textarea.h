@@ -54,6 +54,10 @@ class Textarea: public Container {
 		cursor_t getCursor()const				{	return cursor;	}
 		cursor_t getSelectionStart()const		{	return selectionStart;	}
 		size_t getNumberOfLines()const			{	return lines.size();	}
+
+		//! If enabled, lines wider than the textarea are broken at whitespace into several rows.
+		void setSoftWrap(bool b);
+		bool isSoftWrapEnabled()const			{	return softWrap;	}
 	private:
 		cursor_t trimToLineLength(cursor_t p)const{	return std::make_pair(p.first,std::min(getLine(p.first).length(),p.second)); }
 		
@@ -81,6 +85,7 @@ class Textarea: public Container {
 		std::vector<std::string> lines;
 		Util::Reference<AbstractFont> fontReference; // this is updated by the actual font property on each call of display
 		uint32_t lineHeight;
+		bool softWrap;
 		cursor_t cursor;
 		cursor_t selectionStart;
 		bool dataChanged;
@@ -143,6 +148,8 @@ public:
 
 	virtual void onLinesInserted(Textarea&,size_t first,size_t number) = 0;
 	virtual void onLineErased(Textarea&,size_t first,size_t number) = 0;
+	//! Called whenever the content of the lines [first,last] is changed.
+	virtual void onLinesChanged(Textarea&,size_t first,size_t last) = 0;
 
 };
 
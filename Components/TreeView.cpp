@@ -233,6 +233,19 @@ void TreeView::TreeViewEntry::removeContent(const Ref & child) {
 	Container::removeContent(e);
 }
 
+/*! [TreeView::TreeViewEntry] ---|> Container
+	Each component is wrapped into its own entry, so the components are added one by one.	*/
+void TreeView::TreeViewEntry::addContents(const children_t & components) {
+	for(const auto & child : components)
+		addContent(child);
+}
+
+//! [TreeView::TreeViewEntry] ---|> Container
+void TreeView::TreeViewEntry::removeContents(const children_t & components) {
+	for(const auto & child : components)
+		removeContent(child);
+}
+
 //! [TreeView::TreeViewEntry] ---|> Container
 void TreeView::TreeViewEntry::clearContents() {
 	unmarkSubtree(this);
@@ -481,6 +494,18 @@ void TreeView::removeContent(const Ref & child) {
 	root->removeContent(child);
 }
 
+//! ---|> Container
+void TreeView::addContents(const children_t & components) {
+	invalidateRegion();
+	root->addContents(components);
+}
+
+//! ---|> Container
+void TreeView::removeContents(const children_t & components) {
+	invalidateRegion();
+	root->removeContents(components);
+}
+
 //! ---|> Container
 void TreeView::clearContents() {
 	unmarkAll();
@@ -61,6 +61,8 @@ class TreeView: public Container {
 				virtual void addContent(const Ref & child) override;
 				virtual void clearContents() override;
 				virtual void removeContent(const Ref & child) override;
+				virtual void addContents(const children_t & components) override;
+				virtual void removeContents(const children_t & components) override;
 				virtual std::vector<Component*> getContents() override;
 				virtual void insertAfter(const Ref & child,const Ref & after) override;
 				virtual void insertBefore(const Ref & child,const Ref & after) override;
@@ -103,6 +105,8 @@ class TreeView: public Container {
 		virtual void addContent(const Ref & child) override;
 		virtual void clearContents() override;
 		virtual void removeContent(const Ref & child) override;
+		virtual void addContents(const children_t & components) override;
+		virtual void removeContents(const children_t & components) override;
 		virtual std::vector<Component*> getContents() override;
 
 		// ---|> Component
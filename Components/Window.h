@@ -65,6 +65,8 @@ class Window : public Container {
 		// ---|> Container
 		virtual void addContent(const Ref & child) override 						{	clientAreaPanel->addContent(child);	}
 		virtual void removeContent(const Ref & child) override 					{	clientAreaPanel->removeContent(child);	}
+		virtual void addContents(const children_t & components) override		{	clientAreaPanel->addContents(components);	}
+		virtual void removeContents(const children_t & components) override	{	clientAreaPanel->removeContents(components);	}
 		virtual size_t getContentsCount()const override							{	return clientAreaPanel->getContentsCount();	}
 		virtual std::vector<Component*> getContents() override					{	return clientAreaPanel->getContents();	}
 		virtual void clearContents() override 									{	clientAreaPanel->clearContents();	}
@@ -35,9 +35,13 @@
 
 #include "Base/AnimationHandler.h"
 #include "Base/Draw.h"
+#include "Base/HitTestIndex.h"
 #include "Base/ImageData.h"
+#include "Base/InputRecording.h"
+#include "Base/LayoutProfiler.h"
 #include "Base/ListenerHelper.h"
 #include "Base/StyleManager.h"
+#include "Base/WorkerPool.h"
 #include "Style/Style.h"
 #include "Style/Colors.h" // \todo remove this!
 
@@ -50,6 +54,7 @@
 #include <Util/UI/Window.h>
 #include <Util/Timer.h>
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iostream>
 
@@ -64,6 +69,11 @@ class GlobalContainer : public Container{
 		}
 		virtual ~GlobalContainer(){};
 
+		// ---|> Component
+		uint32_t layoutChildren() override{
+			return getGUI()._layoutTopLevelComponents();
+		}
+
 		// ---|> Container
 		void bringChildToFront(Component * w) override{
 			if(w==nullptr) return;
@@ -126,7 +136,7 @@ class MouseCursorHandler {
 			activateCursor(nullptr);
 		}
 		std::shared_ptr<Util::UI::Cursor> queryHoverComponentMouseCursor(const Vec2 & absPos)const{
-			for(Component * c=gui.getComponentAtPos(absPos);c!=nullptr;c=c->getParent()){
+			for(const auto & c : gui.getHitPath(absPos)){
 				if(c->hasMouseCursorProperty())
 					return gui.getStyleManager().getMouseCursor(c->getMouseCursorProperty());
 			}
@@ -170,9 +180,9 @@ class TooltipHandler : public Component {
 		}
 
 		Component * findTooltitComponent(const Vec2 & pos)const{
-			for(Component * c=getGUI().getComponentAtPos(pos);c!=nullptr;c=c->getParent()){
+			for(const auto & c : getGUI().getHitPath(pos)){
 				if(hasComponentTooltip(*c))
-					return c;
+					return c.get();
 			}
 			return nullptr;
 		}
@@ -188,18 +198,18 @@ class TooltipHandler : public Component {
 			switch(mode){
 				case ACTIVE:{
 					if(activeComponent.isNull()){
-						startingTime=Util::Timer::now();
+						startingTime=getGUI().getTime();
 						mode=SEARCHING;
 						invalidateRegion();
 					}
 					break;
 				}
 				case SEARCHING:{
-					startingTime=Util::Timer::now();
+					startingTime=getGUI().getTime();
 					break;
 				}
 				case INACTIVE:{
-					startingTime=Util::Timer::now();
+					startingTime=getGUI().getTime();
 					mode=SEARCHING;
 					invalidateRegion();
 					break;
@@ -269,7 +279,7 @@ class TooltipHandler : public Component {
 
 //! (ctor)
 GUI_Manager::GUI_Manager(Util::UI::EventContext * context) : 
-		eventContext(context), window(nullptr), debugMode(0),
+		eventContext(context), window(nullptr), headless(false), inputRecorder(nullptr), lastDisplayTimings(), numberOfNonConvergingLayouts(0), layoutProfiler(nullptr), parallelLayoutRunning(false), absPositionEpoch(1), hitTestGeneration(0), hitTestCount(0), coalescedEventCount(0), debugMode(0),
 		lazyRendering(false), style(new StyleManager),
 		mouseCursorHandler(new MouseCursorHandler(*this)),
 		tooltipHandler(new TooltipHandler(*this)){
@@ -301,10 +311,39 @@ bool GUI_Manager::isShiftPressed() const {
 	return eventContext ? eventContext->isShiftPressed() : false;
 }
 
+//! (internal) While an instance exists, the hit path is shared by all listeners of the handled mouse event.
+class EventHitTestScope{
+		GUI_Manager::EventHitTest & eventHitTest;
+		const bool wasInsideEvent;
+	public:
+		EventHitTestScope(GUI_Manager & gui) : eventHitTest(gui.eventHitTest), wasInsideEvent(gui.eventHitTest.insideEvent) {
+			eventHitTest.insideEvent = true;
+			eventHitTest.valid = false;
+		}
+		~EventHitTestScope(){
+			eventHitTest.insideEvent = wasInsideEvent;
+			eventHitTest.valid = false;
+			eventHitTest.path.clear(); // release the references
+		}
+};
+
+const GUI_Manager::hitPath_t & GUI_Manager::getHitPath(const Geometry::Vec2 & pos){
+	if(eventHitTest.valid && eventHitTest.pos==pos && eventHitTest.generation==hitTestGeneration)
+		return eventHitTest.path;
+	eventHitTest.path.clear();
+	for(Component * c=getComponentAtPos(pos);c!=nullptr;c=c->getParent())
+		eventHitTest.path.emplace_back(c);
+	eventHitTest.pos = pos;
+	eventHitTest.generation = hitTestGeneration;
+	eventHitTest.valid = eventHitTest.insideEvent;
+	return eventHitTest.path;
+}
+
 //! (internal)
 bool GUI_Manager::handleMouseMovement(const Util::UI::MotionEvent & motionEvent){
-	// Use a copy to allow insertions and deletions.
-	for(const auto & handleMouseMoveFun : globalMouseMotionListener.getElementsCopy()) {
+	EventHitTestScope hitTestScope(*this);
+	// Use a snapshot to allow insertions and deletions.
+	for(const auto & handleMouseMoveFun : globalMouseMotionListener.getSnapshot()) {
 		if(handleMouseMoveFun(nullptr, motionEvent)) {
 			return true;
 		}
@@ -314,12 +353,13 @@ bool GUI_Manager::handleMouseMovement(const Util::UI::MotionEvent & motionEvent)
 
 //! (internal)
 bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
+	EventHitTestScope hitTestScope(*this);
 	// Handle global listeners
 	// Use nullptr as component to access global registry.
 	const auto globalIt = mouseButtonListener.find(nullptr);
 	if(globalIt != mouseButtonListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & handleMouseButtonFun : globalIt->second.getElementsCopy()) {
+		// Use a snapshot to allow insertions and deletions.
+		for(const auto & handleMouseButtonFun : globalIt->second.getSnapshot()) {
 			if(handleMouseButtonFun(nullptr, buttonEvent)) {
 				return true;
 			}
@@ -330,7 +370,8 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 	setActiveComponent(nullptr);
 
 	const Geometry::Vec2 absPos(buttonEvent.x, buttonEvent.y);
-	for(Component::Ref c=getComponentAtPos(absPos);
+	const hitPath_t & hitPath = getHitPath(absPos);
+	for(Component::Ref c=hitPath.empty() ? nullptr : hitPath.front();
 			c.isNotNull() && c->isEnabled() && c->coversAbsPosition(absPos);
 			c=c->getParent() ){
 
@@ -338,7 +379,7 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 		if(componentIt == mouseButtonListener.cend()) {
 			continue;
 		}
-		for(const auto & handleMouseButtonFun : componentIt->second.getElementsCopy()) {
+		for(const auto & handleMouseButtonFun : componentIt->second.getSnapshot()) {
 			if(!(handleMouseButtonFun(c.get(), buttonEvent))) {
 				continue;
 			}
@@ -350,8 +391,8 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 			const auto clickIt = mouseClickListener.find(c.get());
 			if(clickIt != mouseClickListener.cend()) {
 				const Geometry::Vec2 localPos = absPos - c->getAbsPosition();
-				// Use a copy to allow insertions and deletions.
-				for(const auto & clickListener : clickIt->second.getElementsCopy()) {
+				// Use a snapshot to allow insertions and deletions.
+				for(const auto & clickListener : clickIt->second.getSnapshot()) {
 					if(clickListener(c.get(), buttonEvent.button, localPos)) {
 						break;
 					}
@@ -374,8 +415,8 @@ bool GUI_Manager::handleKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 	for(Component::Ref c=globalContainer->findSelectedComponent();c!=nullptr && c->isEnabled(); c=c->getParent() ){
 		const auto it = keyListener.find(c.get());
 		if(it != keyListener.cend()) {
-			// Use a copy to allow insertions and deletions.
-			for(const auto & fun : it->second.getElementsCopy()) {
+			// Use a snapshot to allow insertions and deletions.
+			for(const auto & fun : it->second.getSnapshot()) {
 				const bool consumed = fun(keyEvent);
 				if(consumed) {
 					return true;
@@ -402,6 +443,8 @@ bool GUI_Manager::handleKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 }
 
 bool GUI_Manager::handleEvent(const Util::UI::Event & e) {
+	if(inputRecorder!=nullptr)
+		inputRecorder->recordEvent(getTime(),e);
 	switch(e.type) {
 		case Util::UI::EVENT_MOUSE_BUTTON:
 			return handleMouseButton(e.button);
@@ -420,10 +463,33 @@ bool GUI_Manager::handleEvent(const Util::UI::Event & e) {
 	return false;
 }
 
+size_t GUI_Manager::handleEvents(const std::vector<Util::UI::Event> & events) {
+	size_t coalesced = 0;
+	for(size_t i = 0; i < events.size(); ++i) {
+		if(events[i].type != Util::UI::EVENT_MOUSE_MOTION) {
+			handleEvent(events[i]);
+			continue;
+		}
+		Util::UI::Event merged = events[i];
+		while(i + 1 < events.size() && events[i + 1].type == Util::UI::EVENT_MOUSE_MOTION &&
+				events[i + 1].motion.buttonMask == merged.motion.buttonMask) {
+			const Util::UI::MotionEvent & next = events[++i].motion;
+			merged.motion.x = next.x;
+			merged.motion.y = next.y;
+			merged.motion.deltaX += next.deltaX;
+			merged.motion.deltaY += next.deltaY;
+			++coalesced;
+		}
+		handleEvent(merged);
+	}
+	coalescedEventCount += coalesced;
+	return coalesced;
+}
+
 void GUI_Manager::enableKeyRepetition(const Util::UI::KeyboardEvent & keyEvent){
 	if(keyRepeatInfo.get()==nullptr || keyRepeatInfo->second.key != keyEvent.key){
 		keyRepeatInfo.reset( new std::pair<float,Util::UI::KeyboardEvent>(
-				Util::Timer::now()+ getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_1),keyEvent) );
+				getTime()+ getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_1),keyEvent) );
 	}
 }
 void GUI_Manager::disableKeyRepetition(){
@@ -442,41 +508,45 @@ void GUI_Manager::unregisterWindow(Component *w){
 }
 
 void GUI_Manager::invalidateRegion(const Rect & region){
+	const auto lock = _lockSharedState();
 	invalidRegion.include(region);
 }
 
 void GUI_Manager::display(){
-	
-	{ // init draw process
+	typedef std::chrono::steady_clock clock_t;
+	auto phaseStart = clock_t::now();
+	// returns the seconds since the end of the previous phase
+	const auto endPhase = [&phaseStart](){
+		const auto now = clock_t::now();
+		const double seconds = std::chrono::duration<double>(now-phaseStart).count();
+		phaseStart = now;
+		return seconds;
+	};
+
+	if(!headless){ // init draw process
 		// update size
 		Geometry::Rect_i viewport = Draw::queryViewport();
 		globalContainer->setSize(viewport.getWidth(), viewport.getHeight());
 		Draw::beginDrawing(Geometry::Vec2i(viewport.getWidth(),viewport.getHeight()));
 	}
+	if(inputRecorder!=nullptr){
+		const Rect screenRect = getScreenRect();
+		inputRecorder->recordFrame(getTime(),static_cast<uint32_t>(screenRect.getWidth()),static_cast<uint32_t>(screenRect.getHeight()));
+	}
 
-			
+	DisplayTimings timings;
+	endPhase();
 	cleanup();
+	timings.cleanupSeconds = endPhase();
 	executeAnimations();
+	timings.animationSeconds = endPhase();
 
-	
-	{ // update layout
-		int lastLayoutCount = 0;
-		for(int i=0;;++i){
-			const int layoutCount = globalContainer->layout();
-			if(layoutCount==0) break;
-			if(i>3 && layoutCount>=lastLayoutCount){
-				if(getDebugMode()>0){
-					// if this message occurs repeatedly, the layout does not converge
-					std::cout << "(!pending layouts: "<< layoutCount <<" )";
-				}
-				// no progress!
-				break;
-			}
-			lastLayoutCount = layoutCount;
-		}
-	}
+	updateLayout();
+	timings.layoutSeconds = endPhase();
 
-	if(isLazyRenderingEnabled()){
+	if(headless){
+		invalidRegion.invalidate();
+	}else if(isLazyRenderingEnabled()){
 		Draw::drawLineRect(invalidRegion,Util::Color4ub(255,0,0,128));
 		pushScissor(Geometry::Rect_i(invalidRegion));
 		Draw::clearScreen(Util::Color4ub(0,0,0,0));
@@ -489,12 +559,13 @@ void GUI_Manager::display(){
 		r.invalidate();
 		globalContainer->display(r);
 	}
+	timings.drawSeconds = endPhase();
 
 	
 	{ // execute frameListeners
-		const double time = Util::Timer::now();
-		// Use a copy to allow insertions and deletions.
-		for(const auto & fun : frameListener.getElementsCopy()) {
+		const double time = getTime();
+		// Use a snapshot to allow insertions and deletions.
+		for(const auto & fun : frameListener.getSnapshot()) {
 			fun(time);
 		}
 
@@ -504,7 +575,103 @@ void GUI_Manager::display(){
 			handleKeyEvent(keyRepeatInfo->second);
 		}
 	}
-	Draw::endDrawing();
+	timings.frameListenerSeconds = endPhase();
+	if(!headless){
+		Draw::endDrawing();
+		timings.drawSeconds += endPhase();
+	}
+	lastDisplayTimings = timings;
+}
+
+void GUI_Manager::updateLayout(){
+	if(layoutProfiler!=nullptr)
+		layoutProfiler->_beginPass(getTime());
+	globalContainer->layout();
+	if(layoutProfiler!=nullptr)
+		layoutProfiler->_endPass();
+
+	// Components with cyclic size dependencies have been left invalid. As their ancestors were not informed
+	// while being layouted, the components are invalidated again to be layouted in the next frame.
+	numberOfNonConvergingLayouts = nonConvergingLayouts.size();
+	for(const auto & c : nonConvergingLayouts){
+		if(getDebugMode()>0){
+			// if this message occurs repeatedly, the layout does not converge
+			std::cout << "(!pending layout: "<< c->toString() <<" )";
+		}
+		if(!c->isDestroyed())
+			c->invalidateLayout();
+	}
+	nonConvergingLayouts.clear();
+}
+
+void GUI_Manager::_layoutDidNotConverge(Component * c){
+	const auto lock = _lockSharedState();
+	nonConvergingLayouts.push_back(c);
+	if(layoutProfiler!=nullptr)
+		layoutProfiler->_layoutDidNotConverge(*c);
+}
+
+void GUI_Manager::setNumberOfLayoutThreads(uint32_t numThreads){
+	layoutWorkers.reset(numThreads>1 ? new WorkerPool(numThreads-1) : nullptr);
+}
+
+uint32_t GUI_Manager::getNumberOfLayoutThreads()const{
+	return layoutWorkers ? layoutWorkers->getNumberOfWorkers()+1 : 1;
+}
+
+std::unique_lock<std::recursive_mutex> GUI_Manager::_lockSharedState(){
+	return parallelLayoutRunning ? std::unique_lock<std::recursive_mutex>(sharedStateMutex) : std::unique_lock<std::recursive_mutex>();
+}
+
+uint32_t GUI_Manager::_layoutTopLevelComponents(){
+	std::vector<Component *> components;
+	for(const auto & c : globalContainer->getChildren()){
+		if(c->isEnabled() && (!c->getFlag(Component::LAYOUT_VALID) || !c->getFlag(Component::SUBTREE_LAYOUT_VALID)))
+			components.push_back(c.get());
+	}
+	if(!layoutWorkers || components.size()<2 || parallelLayoutRunning || layoutProfiler!=nullptr)
+		return globalContainer->Component::layoutChildren();
+
+	/* The top-level components only share the global container: its absolute position is validated beforehand
+		and the changes of their rects are reported to it afterwards (see Component::setRect(...)).	*/
+	globalContainer->getAbsPosition();
+	std::vector<Geometry::Rect> oldRects;
+	oldRects.reserve(components.size());
+	for(const auto & c : components)
+		oldRects.push_back(c->getRect());
+
+	const StyleManager::ThreadStacks styleStacks = getStyleManager().createThreadStacks();
+	std::atomic<uint32_t> count(0);
+	std::vector<WorkerPool::task_t> tasks;
+	tasks.reserve(components.size());
+	for(const auto & c : components){
+		tasks.emplace_back([this,c,&styleStacks,&count](){
+			const StyleManager::ThreadScope styleScope(getStyleManager(),styleStacks);
+			count += c->layout();
+		});
+	}
+	parallelLayoutRunning = true;
+	try{
+		layoutWorkers->execute(tasks);
+	}catch(...){
+		parallelLayoutRunning = false;
+		throw;
+	}
+	parallelLayoutRunning = false;
+
+	for(size_t i = 0; i<components.size(); ++i){
+		if(components[i]->getRect()!=oldRects[i])
+			globalContainer->childRectChanged(components[i]);
+	}
+	return count;
+}
+
+double GUI_Manager::getTime()const{
+	return timeSource ? timeSource() : Util::Timer::now();
+}
+
+void GUI_Manager::setScreenSize(uint32_t width,uint32_t height){
+	globalContainer->setSize(width,height);
 }
 
 void GUI_Manager::setActiveComponent(Component * c){
@@ -518,7 +685,7 @@ void GUI_Manager::unselectAll(){
 
 void GUI_Manager::closeAllMenus(){
 	for(Component * c = globalContainer->getFirstChild();c!=nullptr;c=c->getNext()){
-		if(Menu * m = dynamic_cast<Menu*>(c))
+		if(Menu * m = component_cast<Menu>(c))
 			m->close();
 	}
 }
@@ -558,7 +725,7 @@ bool GUI_Manager::selectFirst(Component * c){
 		c->select();
 		return true;
 	}
-	Container * con=dynamic_cast<Container*>(c);
+	Container * con=component_cast<Container>(c);
 	if(con==nullptr){
 		return false;
 	}
@@ -580,7 +747,7 @@ bool GUI_Manager::selectLast(Component * c){
 		c->select();
 		return true;
 	}
-	Container * con=dynamic_cast<Container*>(c);
+	Container * con=component_cast<Container>(c);
 	if(con==nullptr)
 		return false;
 	for(c=con->getLastChild();c!=nullptr;c=c->getPrev()){
@@ -591,8 +758,8 @@ bool GUI_Manager::selectLast(Component * c){
 }
 
 void GUI_Manager::componentActionPerformed(Component * c, const Util::StringIdentifier & actionName) {
-	// Use a copy to allow insertions and deletions.
-	for(const auto & handleAction : actionListener.getElementsCopy()) {
+	// Use a snapshot to allow insertions and deletions.
+	for(const auto & handleAction : actionListener.getSnapshot()) {
 		if(handleAction(c, actionName)) {
 			return;
 		}
@@ -600,11 +767,12 @@ void GUI_Manager::componentActionPerformed(Component * c, const Util::StringIden
 }
 
 void GUI_Manager::componentDataChanged(Component * component) {
+	const auto lock = _lockSharedState();
 	// Inform component's data change listener
 	const auto componentIt = dataChangeListener.find(component);
 	if(componentIt != dataChangeListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & changeListener : componentIt->second.getElementsCopy()) {
+		// Use a snapshot to allow insertions and deletions.
+		for(const auto & changeListener : componentIt->second.getSnapshot()) {
 			changeListener(component);
 		}
 	}
@@ -612,27 +780,64 @@ void GUI_Manager::componentDataChanged(Component * component) {
 	// Use nullptr as component to access global registry.
 	const auto globalIt = dataChangeListener.find(nullptr);
 	if(globalIt != dataChangeListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & changeListener : globalIt->second.getElementsCopy()) {
+		// Use a snapshot to allow insertions and deletions.
+		for(const auto & changeListener : globalIt->second.getSnapshot()) {
 			changeListener(component);
 		}
 	}
 }
 
 void GUI_Manager::componentDestruction(const Component * component) {
+	const auto lock = _lockSharedState();
 	// Inform functions listening for a component's destruction
 	const auto componentIt = componentDestructionListener.find(component);
 	if(componentIt != componentDestructionListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & onComponentDestruction : componentIt->second.getElementsCopy()) {
+		// Use a snapshot to allow insertions and deletions.
+		for(const auto & onComponentDestruction : componentIt->second.getSnapshot()) {
 			onComponentDestruction();
 		}
-		componentDestructionListener.erase(componentIt);
+		componentDestructionListener.erase(component); // the listeners may have changed the map
+	}
+	hitTestIndices.erase(component);
+}
+
+//! (internal) Erase the entries of the given components; iterates over the smaller one of both containers.
+template<class ListenerMap_t>
+static void eraseComponentEntries(ListenerMap_t & listenerMap,const std::unordered_set<const Component *> & components){
+	if(listenerMap.size()<components.size()){
+		for(auto it = listenerMap.begin(); it!=listenerMap.end(); )
+			it = components.count(it->first)>0 ? listenerMap.erase(it) : std::next(it);
+	}else{
+		for(const Component * c : components)
+			listenerMap.erase(const_cast<Component *>(c));
 	}
 }
 
+void GUI_Manager::removeComponentListeners(const std::unordered_set<const Component *> & components) {
+	const auto lock = _lockSharedState();
+	eraseComponentEntries(dataChangeListener,components);
+	eraseComponentEntries(keyListener,components);
+	eraseComponentEntries(mouseButtonListener,components);
+	eraseComponentEntries(mouseClickListener,components);
+	eraseComponentEntries(hitTestIndices,components);
+}
+
 Component * GUI_Manager::getComponentAtPos(const Geometry::Vec2 & pos){
-	return globalContainer->getComponentAtPos(pos);
+	++hitTestCount;
+	// \note this has to return the same component as globalContainer->getComponentAtPos(pos)
+	if(!globalContainer->isEnabled() || !globalContainer->coversAbsPosition(pos))
+		return nullptr;
+	for(Component * c=globalContainer->getLastChild(); c!=nullptr; c=c->getPrev()){
+		if(!c->isEnabled() || !c->coversAbsPosition(pos))
+			continue;
+		std::unique_ptr<HitTestIndex> & index = hitTestIndices[c];
+		if(!index)
+			index.reset(new HitTestIndex(c));
+		Component * found = index->getComponentAtPos(pos);
+		if(found!=nullptr)
+			return found;
+	}
+	return globalContainer->getFlag(Component::TRANSPARENT_COMPONENT) ? nullptr : globalContainer.get();
 }
 
 bool GUI_Manager::isCurrentlyEnabled(Component * c)const{
@@ -673,17 +878,16 @@ void GUI_Manager::popScissor() {
 // -----------
 // ---- Cleanup
 void GUI_Manager::markForRemoval(Component *c){
+	const auto lock = _lockSharedState();
 	if(c!=nullptr)
 		removalList.push_back(c);
 }
 
 void GUI_Manager::cleanup(){
 	if(!removalList.empty()){
-		std::list<Util::Reference<Component>> l;
+		std::vector<Util::Reference<Component>> l;
 		l.swap(removalList);
-		for(const auto & componentRef : l) {
-			Component::destroy(componentRef.get());
-		}
+		Component::destroy(l);
 	}
 }
 
@@ -693,12 +897,12 @@ void GUI_Manager::cleanup(){
 
 void GUI_Manager::addAnimationHandler(AnimationHandler * h){
 	animationHandlerList.emplace_back(h);
-	h->setStartTime( Util::Timer::now() );
+	h->setStartTime( getTime() );
 }
 
 //! (internal)
 void GUI_Manager::executeAnimations(){
-	const float t = Util::Timer::now();
+	const float t = getTime();
 	animationHandlerList_t animationHandlerList2;
 	animationHandlerList2.reserve( animationHandlerList.size() );
 	std::swap(animationHandlerList2,animationHandlerList);
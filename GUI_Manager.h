@@ -14,11 +14,16 @@
 #include "Base/Listener.h"
 #include "Components/Component.h"
 #include <Util/Graphics/Color.h>
-#include <Util/Registry.h>
 #include <Util/AttributeProvider.h>
 
+#include <atomic>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <stack>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 // Forward declarations
@@ -62,10 +67,14 @@ class Window;
 class TreeView;
 class Entry;
 class AnimationHandler;
+class HitTestIndex;
+class InputRecorder;
+class LayoutProfiler;
 class Style;
 class MouseCursorHandler;
 class MouseCursor;
 class TooltipHandler;
+class WorkerPool;
 
 /***
  ** GUI_Manager
@@ -95,7 +104,18 @@ class GUI_Manager {
 		GUI_Manager(Util::UI::EventContext * context=nullptr);
 		~GUI_Manager();
 		bool handleEvent(const Util::UI::Event & e);
+		/*! Handle the events in the given order. Consecutive mouse motion events with the same button mask
+			are merged into a single event having the position of the last one and the summed up deltas,
+			so that the hover, tooltip and cursor handling is done once per run of motion events.
+			Button and keyboard events are never merged and keep their order relative to the motion events.
+			Returns the number of events that were merged into a preceding one.	*/
+		size_t handleEvents(const std::vector<Util::UI::Event> & events);
+		//! Number of motion events merged by handleEvents(...) so far.
+		uint64_t getCoalescedEventCount()const	{	return coalescedEventCount;	}
 		void display();
+		/*! Layout all invalid components in a single pass (see Component::layout()); called by display().
+			The time needed by display()'s call is reported by getLastDisplayTimings().	*/
+		void updateLayout();
 		Geometry::Rect getScreenRect()const;
 
 		//! Associate a window (e.g. X11 or SDL) to the GUI manager
@@ -115,6 +135,49 @@ class GUI_Manager {
 		std::string alternativeClipboard; // used if no window is available to provide the clipboard.
 	//	@}
 
+	// ----------
+
+	//! @name Time, headless mode and input recording
+	//	@{
+	public:
+		typedef std::function<double ()> timeSource_t;
+
+		//! The time in seconds used for animations, tooltips, key repetition and frame listeners.
+		double getTime()const;
+		//! Replace the clock (e.g. by a simulated one when replaying recorded input); an empty function restores Util::Timer::now().
+		void setTimeSource(timeSource_t source)						{	timeSource = std::move(source);	}
+		//! The clock set by setTimeSource(...); empty if Util::Timer::now() is used.
+		const timeSource_t & getTimeSource()const					{	return timeSource;	}
+
+		/*! In headless mode, display() does the cleanup, the animations, the layout and calls the frame listeners,
+			but issues no drawing commands; no OpenGL context is required. The screen size is not taken from the
+			viewport but has to be set with setScreenSize(...).	*/
+		void setHeadless(bool b)									{	headless = b;	}
+		bool isHeadless()const										{	return headless;	}
+		void setScreenSize(uint32_t width,uint32_t height);
+
+		/*! All events passed to handleEvent(...) and all calls of display() are written to the given recorder
+			(see InputRecorder); nullptr stops the recording. The recorder is not owned by the GUI_Manager.	*/
+		void setInputRecorder(InputRecorder * recorder)				{	inputRecorder = recorder;	}
+		InputRecorder * getInputRecorder()const						{	return inputRecorder;	}
+
+		//! Wall-clock time needed by the phases of a call of display().
+		struct DisplayTimings{
+			double cleanupSeconds;			//!< cleanup() of the components marked for removal
+			double animationSeconds;		//!< execution of the animation handlers
+			double layoutSeconds;			//!< updateLayout(), including the layout dirtied by the animations and removals
+			double drawSeconds;				//!< drawing of the invalid region (no drawing commands in headless mode)
+			double frameListenerSeconds;	//!< frame listeners and key repetition
+		};
+		//! The timings of the last call of display().
+		const DisplayTimings & getLastDisplayTimings()const			{	return lastDisplayTimings;	}
+	private:
+		timeSource_t timeSource;
+		bool headless;
+		InputRecorder * inputRecorder;
+		DisplayTimings lastDisplayTimings;
+	//	@}
+
 	// --------------------------------------------------------------------------------
 
 	//! @name Animation handling
@@ -137,7 +200,47 @@ class GUI_Manager {
 		void markForRemoval(Component *c);
 		void cleanup();
 	private:
-		std::list<Util::Reference<Component> > removalList;
+		std::vector<Util::Reference<Component> > removalList;
+	//	@}
+
+	// ----------
+
+	//! @name Layout
+	//	@{
+	public:
+		//! (internal) Called by Component::layout() if the layout of the component does not converge.
+		void _layoutDidNotConverge(Component * c);
+		//! Number of components whose layout did not converge during the last call of updateLayout().
+		size_t getNumberOfNonConvergingLayouts()const				{	return numberOfNonConvergingLayouts;	}
+
+		/*! Record the layout passes of updateLayout() with the given profiler (see LayoutProfiler); nullptr stops the profiling.
+			The profiler is not owned by the GUI_Manager.	*/
+		void setLayoutProfiler(LayoutProfiler * profiler)			{	layoutProfiler = profiler;	}
+		LayoutProfiler * getLayoutProfiler()const					{	return layoutProfiler;	}
+
+		/*! Opt-in: If @p numThreads is greater than one, the top-level components (e.g. windows) are layouted in parallel
+			by the calling thread and @p numThreads-1 worker threads; 0 or 1 disables the parallel layout.
+			While a layout profiler is set, the layout is done sequentially.
+			Each thread uses its own copy of the style stacks (see StyleManager::ThreadScope) and the GUI_Manager's
+			state changed during the layout (invalid region, listener registries, component destruction, removal list)
+			is synchronized. The result is the same as the sequential layout's.
+			\note The layout of a top-level component must only change components of its own subtree and must not
+				change other shared state (e.g. other listeners, the style defaults or global values).	*/
+		void setNumberOfLayoutThreads(uint32_t numThreads);
+		uint32_t getNumberOfLayoutThreads()const;
+		bool isParallelLayoutRunning()const							{	return parallelLayoutRunning;	}
+
+		//! (internal) Lock the state shared by the top-level components if the parallel layout is running.
+		std::unique_lock<std::recursive_mutex> _lockSharedState();
+		//! (internal) Called by the global container to layout its children (see Component::layoutChildren()).
+		uint32_t _layoutTopLevelComponents();
+	private:
+		std::vector<Util::Reference<Component> > nonConvergingLayouts;
+		size_t numberOfNonConvergingLayouts;
+		LayoutProfiler * layoutProfiler;
+		std::unique_ptr<WorkerPool> layoutWorkers;
+		std::recursive_mutex sharedStateMutex;
+		bool parallelLayoutRunning;
 	//	@}
 
 	// ----------
@@ -147,6 +250,8 @@ class GUI_Manager {
 	private:
 		Component::Ref activeComponent;
 		Util::Reference<Container> globalContainer;
+		//! Spatial index for getComponentAtPos(...) per top-level component (window).
+		std::unordered_map<const Component *, std::unique_ptr<HitTestIndex>> hitTestIndices;
 	public:
 		void registerWindow(Component * w);
 		void unregisterWindow(Component *w);
@@ -154,6 +259,8 @@ class GUI_Manager {
 		void unselectAll();
 		void setActiveComponent(Component * c);
 		bool isActiveComponent(const Component * c)const 			{	return activeComponent==c;	}
+		/*! Returns the front most enabled, non-transparent component covering the given absolute position.
+			The top-level components are tested front to back using a spatial index per top-level component.	*/
 		Component * getComponentAtPos(const Geometry::Vec2 & pos);
 		void selectNext(Component * c);
 		void selectPrev(Component * c);
@@ -166,6 +273,47 @@ class GUI_Manager {
 		bool isCurrentlyEnabled(Component * c)const;
 
 		void closeAllMenus();
+
+		/*! Incremented whenever the position of any component is changed (see Component::invalidateAbsPosition()).
+			A component's cached absolute position is revalidated at most once per epoch.	*/
+		uint32_t getAbsPositionEpoch()const							{	return absPositionEpoch;	}
+		void _nextAbsPositionEpoch()								{	++absPositionEpoch;	}
+	private:
+		std::atomic<uint32_t> absPositionEpoch; // incremented by the parallel layout as well
+	//	@}
+
+	// ----------
+
+	//! @name Hit test of the current mouse event
+	//	@{
+	public:
+		typedef std::vector<Component::Ref> hitPath_t;
+
+		/*! Returns the component at @p pos (see getComponentAtPos(...)) followed by all its ancestors.
+			While a mouse event is handled, the path for the event's position is determined only once
+			and shared by all listeners, until the hit test index is invalidated (e.g. by a listener scrolling
+			or removing components); the returned reference is valid until the next call.	*/
+		const hitPath_t & getHitPath(const Geometry::Vec2 & pos);
+
+		//! Number of tree traversals done by getComponentAtPos(...) so far (e.g. to check that there is one per mouse event).
+		uint64_t getHitTestCount()const								{	return hitTestCount;	}
+
+		/*! (internal) Called by Component::invalidateHitTestIndex(). If a listener of the current event moves, adds or
+			removes components, the following listeners determine the hit path again.	*/
+		void _nextHitTestGeneration()								{	++hitTestGeneration;	}
+	private:
+		struct EventHitTest{
+			bool insideEvent;	//!< a mouse event is currently handled
+			bool valid;			//!< the path has been determined for the current event
+			uint32_t generation;	//!< hitTestGeneration when the path has been determined
+			Geometry::Vec2 pos;
+			hitPath_t path;
+			EventHitTest() : insideEvent(false), valid(false), generation(0) {}
+		} eventHitTest;
+		std::atomic<uint32_t> hitTestGeneration; // incremented by the parallel layout as well
+		uint64_t hitTestCount;
+		uint64_t coalescedEventCount;
+		friend class EventHitTestScope;
 	//	@}
 
 	// ----------
@@ -182,14 +330,18 @@ class GUI_Manager {
 	// ----------
 
 	//! @name Event handling & Listener
+	/*! The (un)registration of listeners is synchronized during the parallel layout, as components created or destroyed
+		by a layout (e.g. the scroll bars of a ScrollableContainer) register and remove their listeners.	*/
 	//	@{
 	private:
 		ActionListenerRegistry actionListener;
 	public:
 		ActionListenerHandle addActionListener(HandleActionFun fun) {
+			const auto lock = _lockSharedState();
 			return actionListener.registerElement(std::move(fun));
 		}
 		void removeActionListener(ActionListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			actionListener.unregisterElement(std::move(handle));
 		}
 
@@ -199,14 +351,16 @@ class GUI_Manager {
 	public:
 		ComponentDestructionListenerHandle addComponentDestructionListener(const Component * component, 
 																		   HandleComponentDestructionFun fun) {
+			const auto lock = _lockSharedState();
 			return componentDestructionListener[component].registerElement(std::move(fun));
 		}
 		void removeComponentDestructionListener(const Component * component, 
 												ComponentDestructionListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			const auto it = componentDestructionListener.find(component);
 			if(it != componentDestructionListener.cend()) {
 				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
+				if(it->second.empty()) {
 					componentDestructionListener.erase(it);
 				}
 			}
@@ -217,13 +371,15 @@ class GUI_Manager {
 		DataChangeListenerMap dataChangeListener;
 	public:
 		DataChangeListenerHandle addDataChangeListener(Component * component, HandleDataChangeFun fun) {
+			const auto lock = _lockSharedState();
 			return dataChangeListener[component].registerElement(std::move(fun));
 		}
 		void removeDataChangeListener(Component * component, DataChangeListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			const auto it = dataChangeListener.find(component);
 			if(it != dataChangeListener.cend()) {
 				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
+				if(it->second.empty()) {
 					dataChangeListener.erase(it);
 				}
 			}
@@ -241,9 +397,11 @@ class GUI_Manager {
 		FrameListenerRegistry frameListener;
 	public:
 		FrameListenerHandle addFrameListener(FrameListenerFun fun) {
+			const auto lock = _lockSharedState();
 			return frameListener.registerElement(std::move(fun));
 		}
 		void removeFrameListener(FrameListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			frameListener.unregisterElement(std::move(handle));
 		}
 
@@ -252,13 +410,15 @@ class GUI_Manager {
 		KeyListenerMap keyListener;
 	public:
 		KeyListenerHandle addKeyListener(Component * component, HandleKeyFun fun) {
+			const auto lock = _lockSharedState();
 			return keyListener[component].registerElement(std::move(fun));
 		}
 		void removeKeyListener(Component * component, KeyListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			const auto it = keyListener.find(component);
 			if(it != keyListener.cend()) {
 				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
+				if(it->second.empty()) {
 					keyListener.erase(it);
 				}
 			}
@@ -269,13 +429,15 @@ class GUI_Manager {
 		MouseButtonListenerMap mouseButtonListener;
 	public:
 		MouseButtonListenerHandle addMouseButtonListener(Component * component, HandleMouseButtonFun fun) {
+			const auto lock = _lockSharedState();
 			return mouseButtonListener[component].registerElement(std::move(fun));
 		}
 		void removeMouseButtonListener(Component * component, MouseButtonListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			const auto it = mouseButtonListener.find(component);
 			if(it != mouseButtonListener.cend()) {
 				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
+				if(it->second.empty()) {
 					mouseButtonListener.erase(it);
 				}
 			}
@@ -294,13 +456,15 @@ class GUI_Manager {
 		MouseClickListenerMap mouseClickListener;
 	public:
 		MouseClickListenerHandle addMouseClickListener(Component * component, HandleMouseClickFun fun) {
+			const auto lock = _lockSharedState();
 			return mouseClickListener[component].registerElement(std::move(fun));
 		}
 		void removeMouseClickListener(Component * component, MouseClickListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			const auto it = mouseClickListener.find(component);
 			if(it != mouseClickListener.cend()) {
 				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
+				if(it->second.empty()) {
 					mouseClickListener.erase(it);
 				}
 			}
@@ -310,9 +474,11 @@ class GUI_Manager {
 		MouseMotionListenerRegistry globalMouseMotionListener;
 	public:
 		MouseMotionListenerHandle addGlobalMouseMotionListener(HandleMouseMotionFun fun) {
+			const auto lock = _lockSharedState();
 			return globalMouseMotionListener.registerElement(std::move(fun));
 		}
 		void removeGlobalMouseMotionListener(MouseMotionListenerHandle handle) {
+			const auto lock = _lockSharedState();
 			globalMouseMotionListener.unregisterElement(std::move(handle));
 		}
 
@@ -321,6 +487,10 @@ class GUI_Manager {
 		void componentActionPerformed(Component *c,const Util::StringIdentifier & actionName);
 		void componentDataChanged(Component * c);
 		void componentDestruction(const Component * component);
+		/*! Remove all component specific listeners (data change, key, mouse button and mouse click) of the given
+			components with one pass over each listener map; used by Component::destroy(...).
+			The component destruction listeners are kept, as they are called when the components are deleted.	*/
+		void removeComponentListeners(const std::unordered_set<const Component *> & components);
 
 		bool isCtrlPressed() const;
 		bool isShiftPressed() const;
@@ -13,9 +13,39 @@
 #include <Util/Graphics/Bitmap.h>
 #include <Util/Graphics/BitmapUtils.h>
 #include <Util/Graphics/PixelFormat.h>
+#include <memory>
 
 namespace GUI{
 
+//! (internal) Glyph of an embedded font; the uv rect is calculated at compile time.
+template<uint32_t atlasWidth,uint32_t atlasHeight>
+struct EmbeddedGlyph{
+	uint32_t codePoint;
+	int32_t width, height, screenX, screenY, xAdvance;
+	float u, v, uvWidth, uvHeight;
+
+	constexpr EmbeddedGlyph(uint32_t _codePoint, int32_t _width, int32_t _height, int32_t textureX, int32_t textureY,
+							int32_t _screenX, int32_t _screenY, int32_t _xAdvance) :
+			codePoint(_codePoint), width(_width), height(_height), screenX(_screenX), screenY(_screenY), xAdvance(_xAdvance),
+			u(static_cast<float>(textureX)/atlasWidth), v(static_cast<float>(textureY)/atlasHeight),
+			uvWidth(static_cast<float>(_width)/atlasWidth), uvHeight(static_cast<float>(_height)/atlasHeight) {}
+};
+
+/*! (internal) The atlas is expanded only once per process and shared by all fonts created from it;
+	its pixels are uploaded directly without creating a copy.	*/
+template<uint32_t atlasWidth,uint32_t atlasHeight,size_t numGlyphs>
+static BitmapFont * createEmbeddedFont(const Util::Reference<Util::Bitmap> & atlas, int lineHeight,
+										const EmbeddedGlyph<atlasWidth,atlasHeight> (&glyphs)[numGlyphs]){
+	Util::Reference<BitmapFont> font = new BitmapFont(new ImageData(atlasWidth,atlasHeight,atlas->getPixelFormat(),atlas->data(),
+																	std::shared_ptr<const void>()), // the atlas is static
+														lineHeight);
+	for(const auto & g : glyphs){
+		font->addGlyph(g.codePoint, BitmapFont::Glyph(	Geometry::Rect(g.u,g.v,g.uvWidth,g.uvHeight),
+														Geometry::Rect_i(g.screenX,g.screenY,g.width,g.height),g.xAdvance));
+	}
+	return font.detachAndDecrease();
+}
+
 //! (static)
 BitmapFont * EmbeddedFonts::createFont(){
 // resources/Fonts/pf_tempesta_seven_condensed.fnt
@@ -57,104 +87,106 @@ BitmapFont * EmbeddedFonts::createFont(){
 		 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 		 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 	};
-	Util::Reference<Util::Bitmap> bitmap = Util::BitmapUtils::createBitmapFromBitMask(96,96,Util::PixelFormat::RGBA,sizeof(bitmapData),bitmapData);
-	Util::Reference<BitmapFont> font = new BitmapFont(new ImageData(bitmap.get()),13);
-	font->addGlyph(32,1,1,Geometry::Vec2i(41,74),Geometry::Vec2i(0,10), 3);
-	font->addGlyph(33,1,7,Geometry::Vec2i(2,66),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(34,3,2,Geometry::Vec2i(22,69),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(35,5,7,Geometry::Vec2i(36,38),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(36,5,9,Geometry::Vec2i(30,11),Geometry::Vec2i(0,1), 6);
-	font->addGlyph(37,7,7,Geometry::Vec2i(58,30),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(38,4,7,Geometry::Vec2i(35,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(39,1,2,Geometry::Vec2i(94,68),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(40,2,9,Geometry::Vec2i(3,22),Geometry::Vec2i(0,1), 3);
-	font->addGlyph(41,2,9,Geometry::Vec2i(6,22),Geometry::Vec2i(0,1), 3);
-	font->addGlyph(42,5,5,Geometry::Vec2i(0,74),Geometry::Vec2i(0,3), 6);
-	font->addGlyph(43,5,5,Geometry::Vec2i(88,62),Geometry::Vec2i(0,3), 6);
-	font->addGlyph(44,2,2,Geometry::Vec2i(13,78),Geometry::Vec2i(0,8), 3);
-	font->addGlyph(45,3,1,Geometry::Vec2i(37,74),Geometry::Vec2i(0,6), 4);
-	font->addGlyph(46,1,1,Geometry::Vec2i(18,47),Geometry::Vec2i(1,8), 3);
-	font->addGlyph(47,5,7,Geometry::Vec2i(72,30),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(48,4,7,Geometry::Vec2i(40,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(49,2,7,Geometry::Vec2i(88,54),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(50,4,7,Geometry::Vec2i(45,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(51,4,7,Geometry::Vec2i(50,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(52,4,7,Geometry::Vec2i(55,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(53,4,7,Geometry::Vec2i(60,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(54,4,7,Geometry::Vec2i(70,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(55,4,7,Geometry::Vec2i(15,49),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(56,4,7,Geometry::Vec2i(80,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(57,4,7,Geometry::Vec2i(85,46),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(58,1,5,Geometry::Vec2i(94,62),Geometry::Vec2i(1,4), 3);
-	font->addGlyph(59,2,6,Geometry::Vec2i(19,65),Geometry::Vec2i(0,4), 3);
-	font->addGlyph(60,3,5,Geometry::Vec2i(59,68),Geometry::Vec2i(0,3), 4);
-	font->addGlyph(61,3,3,Geometry::Vec2i(86,68),Geometry::Vec2i(0,4), 4);
-	font->addGlyph(62,3,5,Geometry::Vec2i(63,68),Geometry::Vec2i(0,3), 4);
-	font->addGlyph(63,4,7,Geometry::Vec2i(0,58),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(64,8,9,Geometry::Vec2i(21,11),Geometry::Vec2i(0,1), 9);
-	font->addGlyph(65,4,7,Geometry::Vec2i(5,58),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(66,4,7,Geometry::Vec2i(15,57),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(67,4,7,Geometry::Vec2i(20,55),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(68,4,7,Geometry::Vec2i(25,55),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(69,4,7,Geometry::Vec2i(30,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(70,4,7,Geometry::Vec2i(35,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(71,4,7,Geometry::Vec2i(45,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(72,4,7,Geometry::Vec2i(50,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(73,1,7,Geometry::Vec2i(6,66),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(74,3,7,Geometry::Vec2i(84,54),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(75,4,7,Geometry::Vec2i(55,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(76,3,7,Geometry::Vec2i(80,54),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(77,5,7,Geometry::Vec2i(30,38),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(78,5,7,Geometry::Vec2i(90,30),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(79,4,7,Geometry::Vec2i(65,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(80,4,7,Geometry::Vec2i(75,54),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(81,4,8,Geometry::Vec2i(51,21),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(82,4,7,Geometry::Vec2i(42,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(83,4,7,Geometry::Vec2i(47,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(84,5,7,Geometry::Vec2i(18,39),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(85,4,7,Geometry::Vec2i(52,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(86,5,7,Geometry::Vec2i(12,41),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(87,5,7,Geometry::Vec2i(0,42),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(88,4,7,Geometry::Vec2i(57,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(89,5,7,Geometry::Vec2i(78,30),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(90,4,7,Geometry::Vec2i(62,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(91,2,9,Geometry::Vec2i(0,23),Geometry::Vec2i(0,1), 3);
-	font->addGlyph(92,5,7,Geometry::Vec2i(84,30),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(93,2,9,Geometry::Vec2i(9,22),Geometry::Vec2i(0,1), 3);
-	font->addGlyph(94,3,2,Geometry::Vec2i(9,80),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(95,3,1,Geometry::Vec2i(25,78),Geometry::Vec2i(0,8), 4);
-	font->addGlyph(96,2,2,Geometry::Vec2i(19,78),Geometry::Vec2i(0,-1), 3);
-	font->addGlyph(97,4,5,Geometry::Vec2i(16,72),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(98,4,7,Geometry::Vec2i(67,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(99,4,5,Geometry::Vec2i(11,72),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(100,4,7,Geometry::Vec2i(72,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(101,4,5,Geometry::Vec2i(6,74),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(102,3,7,Geometry::Vec2i(92,38),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(103,4,7,Geometry::Vec2i(77,38),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(104,4,7,Geometry::Vec2i(82,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(105,1,7,Geometry::Vec2i(0,66),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(106,1,8,Geometry::Vec2i(16,31),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(107,4,7,Geometry::Vec2i(87,38),Geometry::Vec2i(0,2), 5);
-	font->addGlyph(108,1,7,Geometry::Vec2i(94,54),Geometry::Vec2i(0,2), 2);
-	font->addGlyph(109,7,5,Geometry::Vec2i(22,63),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(110,4,5,Geometry::Vec2i(31,68),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(111,4,5,Geometry::Vec2i(26,69),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(112,4,7,Geometry::Vec2i(0,50),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(113,4,7,Geometry::Vec2i(5,50),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(114,3,5,Geometry::Vec2i(71,68),Geometry::Vec2i(0,4), 4);
-	font->addGlyph(115,4,5,Geometry::Vec2i(46,68),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(116,3,6,Geometry::Vec2i(15,65),Geometry::Vec2i(0,3), 4);
-	font->addGlyph(117,4,5,Geometry::Vec2i(41,68),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(118,4,5,Geometry::Vec2i(36,68),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(119,5,5,Geometry::Vec2i(58,62),Geometry::Vec2i(0,4), 6);
-	font->addGlyph(120,4,5,Geometry::Vec2i(21,72),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(121,4,7,Geometry::Vec2i(10,49),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(122,3,5,Geometry::Vec2i(67,68),Geometry::Vec2i(0,4), 4);
-	font->addGlyph(123,3,9,Geometry::Vec2i(87,11),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(124,1,9,Geometry::Vec2i(19,21),Geometry::Vec2i(0,1), 2);
-	font->addGlyph(125,3,9,Geometry::Vec2i(91,11),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(126,4,2,Geometry::Vec2i(4,80),Geometry::Vec2i(0,2), 5);
-	return font.detachAndDecrease();
+	// codePoint, width, height, texture offset, screen offset, xAdvance
+	static constexpr EmbeddedGlyph<96,96> glyphs[] = {
+		{32,1,1,41,74,0,10,3},
+		{33,1,7,2,66,0,2,2},
+		{34,3,2,22,69,0,2,4},
+		{35,5,7,36,38,0,2,6},
+		{36,5,9,30,11,0,1,6},
+		{37,7,7,58,30,0,2,8},
+		{38,4,7,35,46,0,2,5},
+		{39,1,2,94,68,0,2,2},
+		{40,2,9,3,22,0,1,3},
+		{41,2,9,6,22,0,1,3},
+		{42,5,5,0,74,0,3,6},
+		{43,5,5,88,62,0,3,6},
+		{44,2,2,13,78,0,8,3},
+		{45,3,1,37,74,0,6,4},
+		{46,1,1,18,47,1,8,3},
+		{47,5,7,72,30,0,2,6},
+		{48,4,7,40,46,0,2,5},
+		{49,2,7,88,54,0,2,3},
+		{50,4,7,45,46,0,2,5},
+		{51,4,7,50,46,0,2,5},
+		{52,4,7,55,46,0,2,5},
+		{53,4,7,60,46,0,2,5},
+		{54,4,7,70,46,0,2,5},
+		{55,4,7,15,49,0,2,5},
+		{56,4,7,80,46,0,2,5},
+		{57,4,7,85,46,0,2,5},
+		{58,1,5,94,62,1,4,3},
+		{59,2,6,19,65,0,4,3},
+		{60,3,5,59,68,0,3,4},
+		{61,3,3,86,68,0,4,4},
+		{62,3,5,63,68,0,3,4},
+		{63,4,7,0,58,0,2,5},
+		{64,8,9,21,11,0,1,9},
+		{65,4,7,5,58,0,2,5},
+		{66,4,7,15,57,0,2,5},
+		{67,4,7,20,55,0,2,5},
+		{68,4,7,25,55,0,2,5},
+		{69,4,7,30,54,0,2,5},
+		{70,4,7,35,54,0,2,5},
+		{71,4,7,45,54,0,2,5},
+		{72,4,7,50,54,0,2,5},
+		{73,1,7,6,66,0,2,2},
+		{74,3,7,84,54,0,2,4},
+		{75,4,7,55,54,0,2,5},
+		{76,3,7,80,54,0,2,4},
+		{77,5,7,30,38,0,2,6},
+		{78,5,7,90,30,0,2,6},
+		{79,4,7,65,54,0,2,5},
+		{80,4,7,75,54,0,2,5},
+		{81,4,8,51,21,0,2,5},
+		{82,4,7,42,38,0,2,5},
+		{83,4,7,47,38,0,2,5},
+		{84,5,7,18,39,0,2,6},
+		{85,4,7,52,38,0,2,5},
+		{86,5,7,12,41,0,2,6},
+		{87,5,7,0,42,0,2,6},
+		{88,4,7,57,38,0,2,5},
+		{89,5,7,78,30,0,2,6},
+		{90,4,7,62,38,0,2,5},
+		{91,2,9,0,23,0,1,3},
+		{92,5,7,84,30,0,2,6},
+		{93,2,9,9,22,0,1,3},
+		{94,3,2,9,80,0,2,4},
+		{95,3,1,25,78,0,8,4},
+		{96,2,2,19,78,0,-1,3},
+		{97,4,5,16,72,0,4,5},
+		{98,4,7,67,38,0,2,5},
+		{99,4,5,11,72,0,4,5},
+		{100,4,7,72,38,0,2,5},
+		{101,4,5,6,74,0,4,5},
+		{102,3,7,92,38,0,2,4},
+		{103,4,7,77,38,0,4,5},
+		{104,4,7,82,38,0,2,5},
+		{105,1,7,0,66,0,2,2},
+		{106,1,8,16,31,0,2,2},
+		{107,4,7,87,38,0,2,5},
+		{108,1,7,94,54,0,2,2},
+		{109,7,5,22,63,0,4,8},
+		{110,4,5,31,68,0,4,5},
+		{111,4,5,26,69,0,4,5},
+		{112,4,7,0,50,0,4,5},
+		{113,4,7,5,50,0,4,5},
+		{114,3,5,71,68,0,4,4},
+		{115,4,5,46,68,0,4,5},
+		{116,3,6,15,65,0,3,4},
+		{117,4,5,41,68,0,4,5},
+		{118,4,5,36,68,0,4,5},
+		{119,5,5,58,62,0,4,6},
+		{120,4,5,21,72,0,4,5},
+		{121,4,7,10,49,0,4,5},
+		{122,3,5,67,68,0,4,4},
+		{123,3,9,87,11,0,1,4},
+		{124,1,9,19,21,0,1,2},
+		{125,3,9,91,11,0,1,4},
+		{126,4,2,4,80,0,2,5},
+	};
+	static const Util::Reference<Util::Bitmap> atlas = Util::BitmapUtils::createBitmapFromBitMask(96,96,Util::PixelFormat::RGBA,sizeof(bitmapData),bitmapData);
+	return createEmbeddedFont(atlas,13,glyphs);
 }
 //- ---------------------------------------------------------------------------------------------------------
 //! (static)
@@ -210,104 +242,106 @@ BitmapFont * EmbeddedFonts::createBoldFont(){
 		 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 		 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 	};
-	Util::Reference<Util::Bitmap> bitmap = Util::BitmapUtils::createBitmapFromBitMask(128,96,Util::PixelFormat::RGBA,sizeof(bitmapData),bitmapData);
-	Util::Reference<BitmapFont> font = new BitmapFont(new ImageData(bitmap.get()),13);
-	font->addGlyph(32,1,1,Geometry::Vec2i(126,11),Geometry::Vec2i(0,10), 5);
-	font->addGlyph(33,2,7,Geometry::Vec2i(10,74),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(34,5,2,Geometry::Vec2i(12,88),Geometry::Vec2i(0,2), 6);
-	font->addGlyph(35,7,7,Geometry::Vec2i(8,58),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(36,6,9,Geometry::Vec2i(16,22),Geometry::Vec2i(0,1), 7);
-	font->addGlyph(37,8,7,Geometry::Vec2i(97,38),Geometry::Vec2i(0,2), 9);
-	font->addGlyph(38,6,7,Geometry::Vec2i(115,62),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(39,2,2,Geometry::Vec2i(30,86),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(40,3,9,Geometry::Vec2i(45,21),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(41,3,9,Geometry::Vec2i(33,22),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(42,6,5,Geometry::Vec2i(39,79),Geometry::Vec2i(0,3), 7);
-	font->addGlyph(43,6,5,Geometry::Vec2i(32,79),Geometry::Vec2i(0,3), 7);
-	font->addGlyph(44,2,2,Geometry::Vec2i(39,85),Geometry::Vec2i(0,8), 3);
-	font->addGlyph(45,4,1,Geometry::Vec2i(58,85),Geometry::Vec2i(0,6), 5);
-	font->addGlyph(46,2,1,Geometry::Vec2i(66,84),Geometry::Vec2i(0,8), 3);
-	font->addGlyph(47,6,7,Geometry::Vec2i(0,74),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(48,7,7,Geometry::Vec2i(24,57),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(49,3,7,Geometry::Vec2i(122,38),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(50,7,7,Geometry::Vec2i(40,57),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(51,7,7,Geometry::Vec2i(48,56),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(52,7,7,Geometry::Vec2i(64,56),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(53,7,7,Geometry::Vec2i(72,55),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(54,7,7,Geometry::Vec2i(80,55),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(55,7,7,Geometry::Vec2i(96,46),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(56,7,7,Geometry::Vec2i(88,54),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(57,7,7,Geometry::Vec2i(104,54),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(58,2,5,Geometry::Vec2i(114,76),Geometry::Vec2i(0,4), 3);
-	font->addGlyph(59,2,6,Geometry::Vec2i(28,73),Geometry::Vec2i(0,4), 3);
-	font->addGlyph(60,4,5,Geometry::Vec2i(94,77),Geometry::Vec2i(0,3), 5);
-	font->addGlyph(61,4,3,Geometry::Vec2i(117,76),Geometry::Vec2i(0,4), 5);
-	font->addGlyph(62,4,5,Geometry::Vec2i(99,77),Geometry::Vec2i(0,3), 5);
-	font->addGlyph(63,7,7,Geometry::Vec2i(112,54),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(64,8,9,Geometry::Vec2i(43,11),Geometry::Vec2i(0,1), 9);
-	font->addGlyph(65,7,7,Geometry::Vec2i(120,54),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(66,7,7,Geometry::Vec2i(0,66),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(67,7,7,Geometry::Vec2i(8,66),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(68,7,7,Geometry::Vec2i(24,65),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(69,7,7,Geometry::Vec2i(32,65),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(70,7,7,Geometry::Vec2i(40,65),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(71,7,7,Geometry::Vec2i(56,64),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(72,7,7,Geometry::Vec2i(72,63),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(73,2,7,Geometry::Vec2i(7,74),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(74,6,7,Geometry::Vec2i(80,63),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(75,7,7,Geometry::Vec2i(106,38),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(76,6,7,Geometry::Vec2i(108,62),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(77,9,7,Geometry::Vec2i(24,41),Geometry::Vec2i(0,2), 10);
-	font->addGlyph(78,8,7,Geometry::Vec2i(88,38),Geometry::Vec2i(0,2), 9);
-	font->addGlyph(79,7,7,Geometry::Vec2i(114,38),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(80,7,7,Geometry::Vec2i(0,50),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(81,7,8,Geometry::Vec2i(74,21),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(82,7,7,Geometry::Vec2i(8,50),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(83,7,7,Geometry::Vec2i(16,49),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(84,8,7,Geometry::Vec2i(52,40),Geometry::Vec2i(0,2), 9);
-	font->addGlyph(85,7,7,Geometry::Vec2i(24,49),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(86,7,7,Geometry::Vec2i(32,49),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(87,10,7,Geometry::Vec2i(13,41),Geometry::Vec2i(0,2), 11);
-	font->addGlyph(88,8,7,Geometry::Vec2i(70,39),Geometry::Vec2i(0,2), 9);
-	font->addGlyph(89,8,7,Geometry::Vec2i(79,39),Geometry::Vec2i(0,2), 9);
-	font->addGlyph(90,6,7,Geometry::Vec2i(101,62),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(91,3,9,Geometry::Vec2i(37,21),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(92,6,7,Geometry::Vec2i(94,62),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(93,3,9,Geometry::Vec2i(41,21),Geometry::Vec2i(0,1), 4);
-	font->addGlyph(94,3,2,Geometry::Vec2i(23,87),Geometry::Vec2i(0,2), 4);
-	font->addGlyph(95,4,1,Geometry::Vec2i(53,85),Geometry::Vec2i(0,8), 5);
-	font->addGlyph(96,2,2,Geometry::Vec2i(36,85),Geometry::Vec2i(0,-1), 3);
-	font->addGlyph(97,7,5,Geometry::Vec2i(116,70),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(98,7,7,Geometry::Vec2i(40,49),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(99,7,5,Geometry::Vec2i(100,70),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(100,7,7,Geometry::Vec2i(48,48),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(101,7,5,Geometry::Vec2i(92,71),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(102,6,7,Geometry::Vec2i(87,63),Geometry::Vec2i(0,2), 7);
-	font->addGlyph(103,7,7,Geometry::Vec2i(56,48),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(104,7,7,Geometry::Vec2i(64,48),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(105,2,7,Geometry::Vec2i(122,62),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(106,2,9,Geometry::Vec2i(49,21),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(107,7,7,Geometry::Vec2i(72,47),Geometry::Vec2i(0,2), 8);
-	font->addGlyph(108,2,7,Geometry::Vec2i(125,30),Geometry::Vec2i(0,2), 3);
-	font->addGlyph(109,10,5,Geometry::Vec2i(44,73),Geometry::Vec2i(0,4), 11);
-	font->addGlyph(110,7,5,Geometry::Vec2i(84,71),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(111,7,5,Geometry::Vec2i(108,70),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(112,7,7,Geometry::Vec2i(80,47),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(113,7,7,Geometry::Vec2i(88,46),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(114,6,5,Geometry::Vec2i(81,77),Geometry::Vec2i(0,4), 7);
-	font->addGlyph(115,7,5,Geometry::Vec2i(24,80),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(116,6,6,Geometry::Vec2i(21,73),Geometry::Vec2i(0,3), 7);
-	font->addGlyph(117,7,5,Geometry::Vec2i(0,82),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(118,7,5,Geometry::Vec2i(8,82),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(119,10,5,Geometry::Vec2i(55,72),Geometry::Vec2i(0,4), 11);
-	font->addGlyph(120,7,5,Geometry::Vec2i(16,81),Geometry::Vec2i(0,4), 8);
-	font->addGlyph(121,8,7,Geometry::Vec2i(61,40),Geometry::Vec2i(0,4), 9);
-	font->addGlyph(122,6,5,Geometry::Vec2i(53,79),Geometry::Vec2i(0,4), 7);
-	font->addGlyph(123,4,9,Geometry::Vec2i(23,22),Geometry::Vec2i(0,1), 5);
-	font->addGlyph(124,2,9,Geometry::Vec2i(52,21),Geometry::Vec2i(0,1), 3);
-	font->addGlyph(125,4,9,Geometry::Vec2i(28,22),Geometry::Vec2i(0,1), 5);
-	font->addGlyph(126,4,2,Geometry::Vec2i(18,87),Geometry::Vec2i(0,2), 5);
-	return font.detachAndDecrease();
+	// codePoint, width, height, texture offset, screen offset, xAdvance
+	static constexpr EmbeddedGlyph<128,96> glyphs[] = {
+		{32,1,1,126,11,0,10,5},
+		{33,2,7,10,74,0,2,3},
+		{34,5,2,12,88,0,2,6},
+		{35,7,7,8,58,0,2,8},
+		{36,6,9,16,22,0,1,7},
+		{37,8,7,97,38,0,2,9},
+		{38,6,7,115,62,0,2,7},
+		{39,2,2,30,86,0,2,3},
+		{40,3,9,45,21,0,1,4},
+		{41,3,9,33,22,0,1,4},
+		{42,6,5,39,79,0,3,7},
+		{43,6,5,32,79,0,3,7},
+		{44,2,2,39,85,0,8,3},
+		{45,4,1,58,85,0,6,5},
+		{46,2,1,66,84,0,8,3},
+		{47,6,7,0,74,0,2,7},
+		{48,7,7,24,57,0,2,8},
+		{49,3,7,122,38,0,2,4},
+		{50,7,7,40,57,0,2,8},
+		{51,7,7,48,56,0,2,8},
+		{52,7,7,64,56,0,2,8},
+		{53,7,7,72,55,0,2,8},
+		{54,7,7,80,55,0,2,8},
+		{55,7,7,96,46,0,2,8},
+		{56,7,7,88,54,0,2,8},
+		{57,7,7,104,54,0,2,8},
+		{58,2,5,114,76,0,4,3},
+		{59,2,6,28,73,0,4,3},
+		{60,4,5,94,77,0,3,5},
+		{61,4,3,117,76,0,4,5},
+		{62,4,5,99,77,0,3,5},
+		{63,7,7,112,54,0,2,8},
+		{64,8,9,43,11,0,1,9},
+		{65,7,7,120,54,0,2,8},
+		{66,7,7,0,66,0,2,8},
+		{67,7,7,8,66,0,2,8},
+		{68,7,7,24,65,0,2,8},
+		{69,7,7,32,65,0,2,8},
+		{70,7,7,40,65,0,2,8},
+		{71,7,7,56,64,0,2,8},
+		{72,7,7,72,63,0,2,8},
+		{73,2,7,7,74,0,2,3},
+		{74,6,7,80,63,0,2,7},
+		{75,7,7,106,38,0,2,8},
+		{76,6,7,108,62,0,2,7},
+		{77,9,7,24,41,0,2,10},
+		{78,8,7,88,38,0,2,9},
+		{79,7,7,114,38,0,2,8},
+		{80,7,7,0,50,0,2,8},
+		{81,7,8,74,21,0,2,8},
+		{82,7,7,8,50,0,2,8},
+		{83,7,7,16,49,0,2,8},
+		{84,8,7,52,40,0,2,9},
+		{85,7,7,24,49,0,2,8},
+		{86,7,7,32,49,0,2,8},
+		{87,10,7,13,41,0,2,11},
+		{88,8,7,70,39,0,2,9},
+		{89,8,7,79,39,0,2,9},
+		{90,6,7,101,62,0,2,7},
+		{91,3,9,37,21,0,1,4},
+		{92,6,7,94,62,0,2,7},
+		{93,3,9,41,21,0,1,4},
+		{94,3,2,23,87,0,2,4},
+		{95,4,1,53,85,0,8,5},
+		{96,2,2,36,85,0,-1,3},
+		{97,7,5,116,70,0,4,8},
+		{98,7,7,40,49,0,2,8},
+		{99,7,5,100,70,0,4,8},
+		{100,7,7,48,48,0,2,8},
+		{101,7,5,92,71,0,4,8},
+		{102,6,7,87,63,0,2,7},
+		{103,7,7,56,48,0,4,8},
+		{104,7,7,64,48,0,2,8},
+		{105,2,7,122,62,0,2,3},
+		{106,2,9,49,21,0,2,3},
+		{107,7,7,72,47,0,2,8},
+		{108,2,7,125,30,0,2,3},
+		{109,10,5,44,73,0,4,11},
+		{110,7,5,84,71,0,4,8},
+		{111,7,5,108,70,0,4,8},
+		{112,7,7,80,47,0,4,8},
+		{113,7,7,88,46,0,4,8},
+		{114,6,5,81,77,0,4,7},
+		{115,7,5,24,80,0,4,8},
+		{116,6,6,21,73,0,3,7},
+		{117,7,5,0,82,0,4,8},
+		{118,7,5,8,82,0,4,8},
+		{119,10,5,55,72,0,4,11},
+		{120,7,5,16,81,0,4,8},
+		{121,8,7,61,40,0,4,9},
+		{122,6,5,53,79,0,4,7},
+		{123,4,9,23,22,0,1,5},
+		{124,2,9,52,21,0,1,3},
+		{125,4,9,28,22,0,1,5},
+		{126,4,2,18,87,0,2,5},
+	};
+	static const Util::Reference<Util::Bitmap> atlas = Util::BitmapUtils::createBitmapFromBitMask(128,96,Util::PixelFormat::RGBA,sizeof(bitmapData),bitmapData);
+	return createEmbeddedFont(atlas,13,glyphs);
 }
 
 
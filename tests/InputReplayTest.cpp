@@ -0,0 +1,145 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <GUI/Base/InputRecording.h>
+#include <GUI/Components/Container.h>
+#include <GUI/Components/Window.h>
+#include <GUI/GUI_Manager.h>
+#include <Util/IO/FileName.h>
+#include <Util/References.h>
+#include <Util/UI/Event.h>
+#include <Util/Util.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file
+ * @brief Headless replay of recorded input
+ *
+ * Usage: InputReplayTest [recording]
+ * Without a recording, a synthetic session (mouse motion and clicks over windows that are resized in between) is
+ * recorded with an InputRecorder and replayed into a second GUI_Manager. In both cases, the replay is done in headless
+ * mode and the time needed by the events and by the phases of GUI_Manager::display() is written to std::cout.
+ */
+
+static const size_t NUM_WINDOWS = 4;
+static const size_t NUM_FRAMES = 200;
+
+static void createScene(GUI::GUI_Manager & gui,std::vector<Util::Reference<GUI::Window>> & windows){
+	gui.setHeadless(true);
+	gui.setScreenSize(1280,1024);
+	for(size_t i = 0; i<NUM_WINDOWS; ++i){
+		Util::Reference<GUI::Window> window = gui.createWindow(Geometry::Rect(10.0f+i*250.0f,10.0f,200,300),"Window");
+		for(size_t j = 0; j<20; ++j)
+			window->addContent(gui.createContainer(Geometry::Rect(0,j*30.0f,150,25)));
+		windows.push_back(window);
+	}
+}
+
+static void recordSession(const Util::FileName & fileName){
+	GUI::GUI_Manager gui(nullptr);
+	std::vector<Util::Reference<GUI::Window>> windows;
+	createScene(gui,windows);
+
+	double time = 0.0;
+	gui.setTimeSource([&time](){	return time;	});
+	GUI::InputRecorder recorder(fileName);
+	gui.setInputRecorder(&recorder);
+	for(size_t frame = 0; frame<NUM_FRAMES; ++frame){
+		time = frame/60.0;
+		Util::UI::Event e;
+		std::memset(&e,0,sizeof(e));
+		e.motion.type = Util::UI::EVENT_MOUSE_MOTION;
+		e.motion.x = static_cast<float>((frame*7)%1280);
+		e.motion.y = static_cast<float>((frame*5)%400);
+		e.motion.deltaX = 7;
+		e.motion.deltaY = 5;
+		gui.handleEvent(e);
+		if(frame%10==0){
+			std::memset(&e,0,sizeof(e));
+			e.button.type = Util::UI::EVENT_MOUSE_BUTTON;
+			e.button.x = static_cast<float>((frame*7)%1280);
+			e.button.y = static_cast<float>((frame*5)%400);
+			e.button.button = Util::UI::MOUSE_BUTTON_LEFT;
+			e.button.pressed = true;
+			gui.handleEvent(e);
+			e.button.pressed = false;
+			gui.handleEvent(e);
+		}
+		if(frame%20==0)
+			windows[(frame/20)%NUM_WINDOWS]->setHeight(frame%40==0 ? 150 : 300);
+		gui.display();
+	}
+	gui.setInputRecorder(nullptr);
+	gui.setTimeSource(GUI::GUI_Manager::timeSource_t());
+}
+
+int main(int argc, char *argv[]) {
+	Util::init();
+
+	const bool synthetic = argc<2;
+	const Util::FileName fileName(synthetic ? "InputReplayTest.rec" : argv[1]);
+	try{
+		if(synthetic)
+			recordSession(fileName);
+		GUI::InputReplayer replayer(fileName);
+		if(synthetic && (replayer.getNumberOfFrames()!=NUM_FRAMES || replayer.getNumberOfEvents()==0)){
+			std::cerr << "The recorded session has not been read completely.\n";
+			return EXIT_FAILURE;
+		}
+
+		GUI::GUI_Manager gui(nullptr);
+		std::vector<Util::Reference<GUI::Window>> windows;
+		createScene(gui,windows);
+		gui.setTimeSource([](){	return 42.0;	});
+		const std::vector<GUI::InputReplayer::FrameTimings> timings = replayer.replay(gui);
+		if(synthetic)
+			std::remove(fileName.getPath().c_str());
+		if(gui.getTime()!=42.0){
+			std::cerr << "The clock of the GUI_Manager has not been restored after the replay.\n";
+			return EXIT_FAILURE;
+		}
+		if(timings.size()!=replayer.getNumberOfFrames()){
+			std::cerr << "Replayed " << timings.size() << " of " << replayer.getNumberOfFrames() << " frames.\n";
+			return EXIT_FAILURE;
+		}
+
+		size_t numEvents = 0;
+		GUI::InputReplayer::FrameTimings total = GUI::InputReplayer::FrameTimings();
+		for(const auto & frame : timings){
+			numEvents += frame.numEvents;
+			total.eventSeconds += frame.eventSeconds;
+			total.display.cleanupSeconds += frame.display.cleanupSeconds;
+			total.display.animationSeconds += frame.display.animationSeconds;
+			total.display.layoutSeconds += frame.display.layoutSeconds;
+			total.display.drawSeconds += frame.display.drawSeconds;
+			total.display.frameListenerSeconds += frame.display.frameListenerSeconds;
+		}
+		if(numEvents!=replayer.getNumberOfEvents()){
+			std::cerr << "Replayed " << numEvents << " of " << replayer.getNumberOfEvents() << " events.\n";
+			return EXIT_FAILURE;
+		}
+		std::cout << "Replayed " << timings.size() << " frames and " << numEvents << " events (seconds):\n"
+				<< "events\t\t" << total.eventSeconds << '\n'
+				<< "cleanup\t\t" << total.display.cleanupSeconds << '\n'
+				<< "animations\t" << total.display.animationSeconds << '\n'
+				<< "layout\t\t" << total.display.layoutSeconds << '\n'
+				<< "draw\t\t" << total.display.drawSeconds << '\n'
+				<< "frame listeners\t" << total.display.frameListenerSeconds << '\n';
+	}catch(const std::exception & e){
+		std::cerr << e.what() << '\n';
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <GUI/Base/LayoutProfiler.h>
+#include <GUI/Base/Layouters/AbstractLayouter.h>
+#include <GUI/Components/Container.h>
+#include <GUI/Components/Window.h>
+#include <GUI/GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @file
+ * @brief Test of the LayoutProfiler's non-convergence diagnostics
+ *
+ * A container whose width depends on its child and a child whose width depends on its parent form the canonical
+ * cyclic size dependency: each layout of the parent widens the child and vice versa. The profiler has to report
+ * the cycle parent -> child -> parent with the responsible layouters.
+ */
+
+//! Sets the width of a container to the extent of its children plus a margin.
+class FitChildrenLayouter : public GUI::AbstractLayouter {
+		PROVIDES_TYPE_NAME(FitChildrenLayouter)
+	public:
+		// ---|> AbstractLayouter
+		void layout(Util::WeakPointer<GUI::Component> component) override {
+			GUI::Container * container = GUI::component_cast<GUI::Container>(component.get());
+			container->setWidth(container->getChildrenExtent().x()+10);
+		}
+};
+
+//! Sets the width of a component to the width of its parent.
+class FillParentLayouter : public GUI::AbstractLayouter {
+		PROVIDES_TYPE_NAME(FillParentLayouter)
+	public:
+		// ---|> AbstractLayouter
+		void layout(Util::WeakPointer<GUI::Component> component) override {
+			component->setWidth(component->getParent()->getWidth());
+		}
+		dependency_t getDependency()const override	{	return DEPENDS_ON_PARENT;	}
+};
+
+static bool containsInvalidation(const std::vector<GUI::LayoutProfiler::InvalidationRecord> & records,
+								const GUI::Component * source,const GUI::Component * target,const char * stepTypeName){
+	for(const auto & record : records){
+		if(record.source==source && record.target==target && record.stepTypeName!=nullptr && std::string(record.stepTypeName)==stepTypeName)
+			return true;
+	}
+	return false;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+
+	GUI::GUI_Manager gui(nullptr);
+	gui.setHeadless(true);
+	gui.setScreenSize(1280,1024);
+
+	GUI::LayoutProfiler profiler;
+	std::ostringstream diagnostics;
+	profiler.setDiagnosticsOutput(&diagnostics);
+	gui.setLayoutProfiler(&profiler);
+
+	Util::Reference<GUI::Window> window = gui.createWindow(Geometry::Rect(10,10,300,200),"Window");
+	Util::Reference<GUI::Container> parent = gui.createContainer(Geometry::Rect(0,0,50,50));
+	Util::Reference<GUI::Container> child = gui.createContainer(Geometry::Rect(0,0,20,20));
+	parent->addLayouter(new FitChildrenLayouter);
+	child->addLayouter(new FillParentLayouter);
+	parent->addContent(child.get());
+	window->addContent(parent.get());
+
+	gui.updateLayout();
+	std::cout << diagnostics.str();
+
+	if(gui.getNumberOfNonConvergingLayouts()==0 || profiler.getPasses().empty()){
+		std::cerr << "The cyclic layout has not been reported.\n";
+		return EXIT_FAILURE;
+	}
+	const GUI::LayoutProfiler::Pass & pass = profiler.getPasses().back();
+	const GUI::LayoutProfiler::NonConvergenceRecord * parentRecord = nullptr;
+	for(const auto & record : pass.nonConvergences){
+		if(pass.layouts[record.layoutIndex].component==parent.get())
+			parentRecord = &record;
+	}
+	if(parentRecord==nullptr){
+		std::cerr << "The non converging parent has not been recorded.\n";
+		return EXIT_FAILURE;
+	}
+	if(parentRecord->cycle.size()!=2
+			|| !containsInvalidation(parentRecord->cycle,parent.get(),child.get(),FitChildrenLayouter::getClassName())
+			|| !containsInvalidation(parentRecord->cycle,child.get(),parent.get(),FillParentLayouter::getClassName())){
+		std::cerr << "The cycle parent -> child -> parent has not been found.\n";
+		return EXIT_FAILURE;
+	}
+	if(diagnostics.str().find("Cycle:")==std::string::npos){
+		std::cerr << "The cycle has not been written to the diagnostics output.\n";
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
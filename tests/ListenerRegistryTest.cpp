@@ -0,0 +1,97 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <GUI/Base/ListenerRegistry.h>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Test of the copy on write semantics of the ListenerRegistry
+ *
+ * Listeners register and unregister listeners (including themselves) while they are called from a snapshot.
+ * The snapshot has to call exactly the listeners registered at its creation, and the registry has to contain
+ * the changes afterwards.
+ */
+
+typedef GUI::ListenerRegistry<std::function<void ()>> Registry;
+
+static bool check(bool condition,const std::string & message){
+	if(!condition)
+		std::cerr << message << '\n';
+	return condition;
+}
+
+//! Call all listeners of a snapshot and return the names of the called ones.
+static std::string callAll(const Registry & registry,std::string & calls){
+	calls.clear();
+	for(const auto & fun : registry.getSnapshot())
+		fun();
+	return calls;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Registry registry;
+	std::string calls;
+	bool ok = check(registry.empty() && registry.getSnapshot().empty(),"A new registry is not empty.");
+
+	Registry::handle_t handleA, handleB, handleC, handleD;
+	// A removes itself and adds D; B removes C, which has not been called yet.
+	handleA = registry.registerElement([&](){
+		calls += 'A';
+		registry.unregisterElement(handleA);
+		handleD = registry.registerElement([&](){	calls += 'D';	});
+	});
+	handleB = registry.registerElement([&](){
+		calls += 'B';
+		registry.unregisterElement(handleC);
+	});
+	handleC = registry.registerElement([&](){	calls += 'C';	});
+	ok &= check(registry.size()==3,"Three listeners have not been registered.");
+
+	ok &= check(callAll(registry,calls)=="ABC","The first snapshot did not call A, B and C but '"+calls+"'.");
+	ok &= check(registry.size()==2,"A and C have not been removed or D has not been added.");
+	ok &= check(callAll(registry,calls)=="BD","The second snapshot did not call B and D but '"+calls+"'.");
+
+	{ // a snapshot kept alive over changes of the registry
+		const Registry::Snapshot snapshot = registry.getSnapshot();
+		registry.unregisterElement(handleB);
+		registry.registerElement([&](){	calls += 'E';	});
+		registry.registerElement([&](){	calls += 'F';	});
+		ok &= check(snapshot.size()==2,"A snapshot has been changed by the registry.");
+		calls.clear();
+		for(const auto & fun : snapshot)
+			fun();
+		ok &= check(calls=="BD","The kept snapshot did not call B and D but '"+calls+"'.");
+	}
+	ok &= check(callAll(registry,calls)=="DEF","The third snapshot did not call D, E and F but '"+calls+"'.");
+
+	// unknown and already removed handles are ignored
+	registry.unregisterElement(handleA);
+	registry.unregisterElement(Registry::handle_t());
+	ok &= check(registry.size()==3,"Removing an unknown handle changed the registry.");
+
+	// every listener removes itself while being called
+	Registry selfRemoving;
+	std::vector<Registry::handle_t> handles(5);
+	for(size_t i = 0; i<handles.size(); ++i){
+		handles[i] = selfRemoving.registerElement([&,i](){
+			calls += static_cast<char>('0'+i);
+			selfRemoving.unregisterElement(handles[i]);
+		});
+	}
+	ok &= check(callAll(selfRemoving,calls)=="01234","Not all self removing listeners have been called: '"+calls+"'.");
+	ok &= check(selfRemoving.empty() && selfRemoving.getSnapshot().empty(),"The self removing listeners have not been removed.");
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
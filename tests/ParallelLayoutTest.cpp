@@ -0,0 +1,93 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <GUI/Components/Container.h>
+#include <GUI/Components/Window.h>
+#include <GUI/GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file
+ * @brief Stress test for the parallel layout of top-level components
+ *
+ * Several windows are resized in the same frames so that their client areas start and stop overflowing at once.
+ * The client areas (ScrollableContainers) then create and destroy their scroll bars concurrently, which registers
+ * and removes listeners of the shared GUI_Manager. The same frames are layouted sequentially by a second
+ * GUI_Manager and the rects of all components have to be equal.
+ */
+
+static const size_t NUM_WINDOWS = 8;
+static const size_t NUM_FRAMES = 500;
+
+struct Scene{
+	GUI::GUI_Manager gui;
+	std::vector<Util::Reference<GUI::Window>> windows;
+
+	explicit Scene(uint32_t numThreads) : gui(nullptr) {
+		gui.setHeadless(true);
+		gui.setScreenSize(1280,1024);
+		gui.setNumberOfLayoutThreads(numThreads);
+		for(size_t i = 0; i<NUM_WINDOWS; ++i){
+			Util::Reference<GUI::Window> window = gui.createWindow(Geometry::Rect(10.0f+i*20.0f,10.0f,150,200),"Window");
+			for(size_t j = 0; j<10; ++j)
+				window->addContent(gui.createContainer(Geometry::Rect(0,j*30.0f,100,25)));
+			windows.push_back(window);
+		}
+	}
+	//! The client areas overflow in odd frames; every third window keeps its size.
+	void resize(size_t frame){
+		for(size_t i = 0; i<windows.size(); ++i){
+			if(i%3!=2)
+				windows[i]->setSize(150,frame%2==1 ? 200 : 400+i);
+		}
+	}
+};
+
+static std::vector<Geometry::Rect> collectRects(GUI::Component & root){
+	struct RectCollector : public GUI::Component::Visitor {
+		std::vector<Geometry::Rect> rects;
+		// ---|> Component::Visitor
+		GUI::Component::visitorResult_t visit(GUI::Component & c) override {
+			rects.push_back(c.getRect());
+			return GUI::Component::CONTINUE_TRAVERSAL;
+		}
+	}collector;
+	root.traverseSubtree(collector);
+	return collector.rects;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+
+	Scene sequential(1);
+	Scene parallel(4);
+	if(parallel.gui.getNumberOfLayoutThreads()!=4){
+		std::cerr << "The parallel layout is not enabled.\n";
+		return EXIT_FAILURE;
+	}
+	for(size_t frame = 0; frame<NUM_FRAMES; ++frame){
+		sequential.resize(frame);
+		parallel.resize(frame);
+		sequential.gui.updateLayout();
+		parallel.gui.updateLayout();
+		for(size_t i = 0; i<NUM_WINDOWS; ++i){
+			if(collectRects(*sequential.windows[i].get())!=collectRects(*parallel.windows[i].get())){
+				std::cerr << "Frame " << frame << ": The layout of window " << i << " differs from the sequential layout.\n";
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	std::cout << "Layouted " << NUM_FRAMES << " frames of " << NUM_WINDOWS << " windows in parallel.\n";
+	return EXIT_SUCCESS;
+}
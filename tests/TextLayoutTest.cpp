@@ -0,0 +1,93 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <GUI/Base/Fonts/TextLayout.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Test of the incremental update of a TextLayout after several edits
+ *
+ * Paragraphs are changed and erased between two updates. After the update, the lines of every paragraph have to
+ * match its current text. Without a font, each paragraph consists of a single line covering the whole paragraph.
+ */
+
+//! Apply the edits, update the layout and compare the lines with the texts.
+static bool updateAndCheck(GUI::TextLayout & layout,const std::vector<std::string> & texts,const std::string & name){
+	layout.update([&texts](size_t i){	return texts[i];	});
+	if(layout.needsUpdate() || layout.getNumberOfParagraphs()!=texts.size() || layout.getNumberOfRows()!=texts.size()){
+		std::cerr << name << ": The layout has not been updated completely.\n";
+		return false;
+	}
+	for(size_t i = 0; i<texts.size(); ++i){
+		const GUI::TextLayout::lines_t & lines = layout.getLines(i);
+		if(lines.size()!=1 || lines.front().end!=texts[i].length() || layout.getFirstRow(i)!=i){
+			std::cerr << name << ": Paragraph " << i << " has not been layouted for its current text.\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+static std::vector<std::string> createTexts(size_t number){
+	std::vector<std::string> texts;
+	for(size_t i = 0; i<number; ++i)
+		texts.push_back("p"+std::to_string(i));
+	return texts;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	bool ok = true;
+	{ // a changed paragraph behind erased ones
+		std::vector<std::string> texts = createTexts(20);
+		GUI::TextLayout layout;
+		layout.reset(texts.size());
+		ok &= updateAndCheck(layout,texts,"Initial layout");
+
+		texts[10] = "changed paragraph";
+		layout.invalidateParagraphs(10,10);
+		texts.erase(texts.begin(),texts.begin()+5);
+		layout.eraseParagraphs(0,5);
+		ok &= updateAndCheck(layout,texts,"Change behind an erase");
+	}
+	{ // a changed paragraph in front of erased ones and a change inside the erased range
+		std::vector<std::string> texts = createTexts(20);
+		GUI::TextLayout layout;
+		layout.reset(texts.size());
+		layout.update([&texts](size_t i){	return texts[i];	});
+
+		texts[2] = "changed paragraph";
+		layout.invalidateParagraphs(2,2);
+		layout.invalidateParagraphs(7,7);
+		texts.erase(texts.begin()+5,texts.begin()+10);
+		layout.eraseParagraphs(5,5);
+		texts[12] = "another changed paragraph";
+		layout.invalidateParagraphs(12,12);
+		ok &= updateAndCheck(layout,texts,"Change in front of an erase");
+	}
+	{ // inserted and erased paragraphs
+		std::vector<std::string> texts = createTexts(20);
+		GUI::TextLayout layout;
+		layout.reset(texts.size());
+		layout.update([&texts](size_t i){	return texts[i];	});
+
+		texts[15] = "changed paragraph";
+		layout.invalidateParagraphs(15,15);
+		texts.insert(texts.begin()+3,{"inserted","paragraphs"});
+		layout.insertParagraphs(3,2);
+		texts.erase(texts.begin(),texts.begin()+8);
+		layout.eraseParagraphs(0,8);
+		ok &= updateAndCheck(layout,texts,"Insert and erase");
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}